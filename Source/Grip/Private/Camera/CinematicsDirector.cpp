@@ -239,10 +239,9 @@ void FCinematicsDirector::Tick(float deltaSeconds)
 
 				// Check to see if the target is visible and stop watching them after a short time if they're not.
 
-				FHitResult hit;
 				FVector testPosition = targetLocation + (Cast<ABaseVehicle>(CameraTarget)->GetLaunchDirection() * 2.0f * 100.0f);
 
-				if (CameraTarget->GetWorld()->LineTraceSingleByChannel(hit, fromLocation, testPosition, ABaseGameMode::ECC_LineOfSightTest, VisibilityQueryParams) == false)
+				if (FVisibilityQueryService::LineOfSight(CameraTarget.Get(), CurrentCameraPoint, CameraTarget.Get(), fromLocation, testPosition, ABaseGameMode::ECC_LineOfSightTest, VisibilityQueryParams, 0.1f, EVisibilityQueryFallback::AssumeVisible) == true)
 				{
 					TargetHiddenTime = 0.0f;
 				}
@@ -387,9 +386,7 @@ void FCinematicsDirector::Tick(float deltaSeconds)
 
 				// Check to see if the target is visible and stop watching them after a short time if they're not.
 
-				FHitResult hit;
-
-				if (CameraTarget->GetWorld()->LineTraceSingleByChannel(hit, fromLocation, targetLocation, ABaseGameMode::ECC_LineOfSightTest, VisibilityQueryParams) == false)
+				if (FVisibilityQueryService::LineOfSight(CameraTarget.Get(), CurrentCameraPoint, CameraTarget.Get(), fromLocation, targetLocation, ABaseGameMode::ECC_LineOfSightTest, VisibilityQueryParams, 0.1f, EVisibilityQueryFallback::AssumeVisible) == true)
 				{
 					TargetHiddenTime = 0.0f;
 				}
@@ -484,7 +481,7 @@ void FCinematicsDirector::Tick(float deltaSeconds)
 				bool cameraIsOld = (CurrentCameraPoint != nullptr && CameraShotTimer > CurrentCameraPoint->MaximumViewSeconds);
 				bool cameraIsNotGreat = (CameraShotTimer >= MinCameraDuration && vehicleValid == true && CurrentCameraPoint != nullptr && CurrentCameraPoint->WasClipped() == true);
 
-				cameraIsNotGreat |= (CameraShotTimer >= MinCameraDuration && vehicleValid == true && CurrentCameraPoint != nullptr && CurrentCameraPoint->HighAngularVelocities == false && CurrentVehicle->IsAirborne() == true);
+				cameraIsNotGreat |= (CameraShotTimer >= MinCameraDuration && vehicleValid == true && CurrentCameraPoint != nullptr && CurrentCameraPoint->HighAngularVelocities == false && CurrentVehicle->GetFrameSnapshot().Airborne == true);
 
 				if (cameraIsOld == true ||
 					cameraIsNotGreat == true ||
@@ -1297,7 +1294,7 @@ bool FCinematicsDirector::HookupMissileImpactFromVehicle(AHomingMissile* missile
 					if (vehicle != nullptr &&
 						vehicle != fromVehicle &&
 						vehicle->GetSpeedKPH() > 300.0f &&
-						vehicle->IsPracticallyGrounded() == true &&
+						vehicle->GetFrameSnapshot().PracticallyGrounded == true &&
 						vehicle->IsVehicleDestroyed() == false &&
 						IsVehicleSmoothlyControlled(vehicle) == true)
 					{
@@ -1311,7 +1308,7 @@ bool FCinematicsDirector::HookupMissileImpactFromVehicle(AHomingMissile* missile
 							{
 								FVector direction = fromVehicle->GetActorLocation() - vehicle->GetActorLocation(); direction.Normalize();
 
-								if (FMath::Abs(FVector::DotProduct(vehicle->GetSurfaceDirection(), direction)) < 0.5f)
+								if (FMath::Abs(FVector::DotProduct(vehicle->GetFrameSnapshot().SurfaceDirection, direction)) < 0.5f)
 								{
 									if (closestDistance < 0.0f ||
 										closestDistance > distanceDifference)
@@ -1331,10 +1328,9 @@ bool FCinematicsDirector::HookupMissileImpactFromVehicle(AHomingMissile* missile
 					VisibilityQueryParams.AddIgnoredActor(closestVehicle);
 					VisibilityQueryParams.AddIgnoredActor(missile);
 
-					FHitResult hit;
 					FVector testPosition = closestVehicle->GetActorLocation() + closestVehicle->GetLaunchDirection() * 2.0f * 100.0f;
 
-					if (closestVehicle->GetWorld()->LineTraceSingleByChannel(hit, testPosition, missile->GetActorLocation(), ABaseGameMode::ECC_LineOfSightTest, VisibilityQueryParams) == false)
+					if (FVisibilityQueryService::LineOfSight(closestVehicle, closestVehicle, missile, testPosition, missile->GetActorLocation(), ABaseGameMode::ECC_LineOfSightTest, VisibilityQueryParams, 0.1f, EVisibilityQueryFallback::AssumeHidden) == true)
 					{
 						CameraTarget = missile;
 
@@ -1420,7 +1416,7 @@ bool FCinematicsDirector::IdentifyVehicleEvent()
 							{
 								FVector toDirection = toVehicle->GetActorLocation() - fromVehicle->GetActorLocation(); toDirection.Normalize();
 
-								if (FMath::Abs(FVector::DotProduct(fromVehicle->GetSurfaceDirection(), toDirection)) < 0.5f)
+								if (FMath::Abs(FVector::DotProduct(fromVehicle->GetFrameSnapshot().SurfaceDirection, toDirection)) < 0.5f)
 								{
 									CameraTarget = toVehicle;
 
@@ -1676,23 +1672,28 @@ float FCinematicsDirector::IdentifyImpactEvent(ABaseVehicle* vehicle, TWeakObjec
 
 	impactingActor = nullptr;
 
-	APlayGameMode* gameMode = APlayGameMode::Get(Owner);
+	// The threats are sorted by time to impact, so we can stop as soon as we go beyond
+	// the maximum impact time.
 
-	for (AHomingMissile* missile : gameMode->Missiles)
+	for (const FIncomingThreat& threat : vehicle->GetIncomingThreats())
 	{
-		if (missile->Target == vehicle &&
+		if (threat.TimeToTarget >= maxImpactTime)
+		{
+			break;
+		}
+
+		AHomingMissile* missile = threat.Missile.Get();
+
+		if (missile != nullptr &&
 			missile->HasExploded() == false &&
-			(missilesOnly == true || missile->IsTargetWithinReach() == true))
+			(missilesOnly == true || threat.WithinReach == true))
 		{
-			if (missile->IsLikelyToHitTarget() == true &&
+			if (threat.LikelyToHit == true &&
 				vehicle->IsShielded(missile->GetActorLocation()) == false)
 			{
-				float time = missile->GetTimeToTarget();
-
-				if (maxTime < time &&
-					time < maxImpactTime)
+				if (maxTime < threat.TimeToTarget)
 				{
-					maxTime = time;
+					maxTime = threat.TimeToTarget;
 					impactingActor = missile;
 				}
 			}
@@ -2778,10 +2779,9 @@ void FSplineCamera::Tick(float deltaSeconds, bool modeReset)
 					// Check to see if the target is visible and stop watching them after a short time
 					// if they're not.
 
-					FHitResult hit;
 					FVector testPosition = Target->GetCenterLocation() + Target->GetLaunchDirection() * 2.0f * 100.0f;
 
-					if (Target->GetWorld()->LineTraceSingleByChannel(hit, WorldLocation, testPosition, ABaseGameMode::ECC_LineOfSightTest, VisibilityQueryParams) == false)
+					if (FVisibilityQueryService::LineOfSight(Target.Get(), this, Target.Get(), WorldLocation, testPosition, ABaseGameMode::ECC_LineOfSightTest, VisibilityQueryParams, 0.1f, EVisibilityQueryFallback::AssumeVisible) == true)
 					{
 						TargetHiddenTime = 0.0f;
 					}
@@ -139,7 +139,7 @@ void UFlippableSpringArmComponent::UpdateDesiredArmProperties(const FTransform&
 			ClippingQueryParams.AddIgnoredActor(vehicle);
 		}
 
-		bool airborne = vehicle->IsAirborne(true);
+		bool airborne = vehicle->GetFrameSnapshot().AirborneIgnoringSkipping;
 
 		if (Airborne != airborne)
 		{
@@ -1525,18 +1525,21 @@ bool UFlippableSpringArmComponent::ClipAgainstVehicles(const FVector& start, FVe
 
 	if (playGameMode != nullptr)
 	{
-		GRIP_GAME_MODE_LIST_FROM(GetVehicles(), vehicles, playGameMode);
+		FVector halfVector = (end - start) * 0.5f;
+		FVector center = start + halfVector;
+		float radius = halfVector.Size();
 
-		// Check each of the vehicles in the game against the spring-arm.
+		// Check each of the vehicles near to the spring-arm against it.
+
+		FVehicleBroadphase::FVehicleList vehicles;
+
+		playGameMode->GetVehicleBroadphase().QueryNeighbours(center, radius + 200.0f, vehicles);
 
 		for (ABaseVehicle* vehicle : vehicles)
 		{
 			if (vehicle != thisVehicle)
 			{
 				FBox box = vehicle->CameraClipBox;
-				FVector halfVector = (end - start) * 0.5f;
-				FVector center = start + halfVector;
-				float radius = halfVector.Size();
 
 				// If this vehicle is close enough to us to warrant a clip check then do just that.
 
@@ -286,13 +286,18 @@ void UElectricalStreakComponent::InitializeComponent()
 	NumPoints = FMathEx::GetPower2(NumPoints);
 	ThisLifeTime = LifeTime.Minimum;
 
-	InitialDelay.GenerateRandom();
+	Random.Seed((RandomSeed != 0) ? (uint32)RandomSeed : (uint32)FMath::Rand());
+
+	InitialDelay.GenerateRandom(Random);
 
 	for (TArray<FLineSegment>& segments : Segments)
 	{
 		segments.Reserve(NumPoints);
 	}
 
+	RandomRolls.Reserve(NumPoints);
+	RandomOffsets.Reserve(NumPoints);
+
 	if (StreakEndColour.R < 0.0f)
 	{
 		StreakEndColour = StreakColour;
@@ -508,7 +513,7 @@ void UElectricalStreakComponent::GenerateElectricity()
 			total += location.Probability;
 		}
 
-		float endSelection = FMath::FRand() * total;
+		float endSelection = Random * total;
 
 		CurrentEndLocation = EndLocations[EndLocations.Num() - 1];
 
@@ -542,8 +547,8 @@ void UElectricalStreakComponent::GenerateElectricity(FVector start, FVector end,
 {
 	if (StrikesEnabled == true)
 	{
-		Width.GenerateRandom();
-		LifeShrinkScale.GenerateRandom();
+		Width.GenerateRandom(Random);
+		LifeShrinkScale.GenerateRandom(Random);
 
 		if (DynamicStreakMaterial != nullptr)
 		{
@@ -560,7 +565,7 @@ void UElectricalStreakComponent::GenerateElectricity(FVector start, FVector end,
 
 		int32 flipFlop = 0;
 		FRotator rotator = FRotator::ZeroRotator;
-		float offsetAmount = end.Size() * Deviation.GetRandom();
+		float offsetAmount = end.Size() * Deviation.GetRandom(Random);
 
 		Segments[flipFlop].Empty(NumPoints);
 		Segments[flipFlop].Emplace(FLineSegment(start, end));
@@ -575,9 +580,17 @@ void UElectricalStreakComponent::GenerateElectricity(FVector start, FVector end,
 
 			newSegments.Empty(NumPoints);
 
+			// Draw all of the random numbers needed for this subdivision in one go.
+
+			RandomRolls.SetNumUninitialized(numSegments, false);
+			RandomOffsets.SetNumUninitialized(numSegments, false);
+
+			Random.FillRange(RandomRolls.GetData(), numSegments, 0.0f, 360.0f);
+			Random.FillRange(RandomOffsets.GetData(), numSegments, -offsetAmount, offsetAmount);
+
 			for (int32 segment = 0; segment < numSegments; segment++)
 			{
-				rotator.Roll = FMath::FRand() * 360.0f;
+				rotator.Roll = RandomRolls[segment];
 
 				FVector segmentStart = oldSegments[segment].Start;
 				FVector segmentEnd = oldSegments[segment].End;
@@ -585,7 +598,7 @@ void UElectricalStreakComponent::GenerateElectricity(FVector start, FVector end,
 				FVector direction = segmentEnd - segmentStart;
 				FQuat quaternion = direction.ToOrientationQuat() * rotator.Quaternion();
 
-				midPoint += quaternion.GetAxisY() * FMath::FRandRange(-offsetAmount, offsetAmount);
+				midPoint += quaternion.GetAxisY() * RandomOffsets[segment];
 
 				newSegments.Emplace(FLineSegment(segmentStart, midPoint));
 				newSegments.Emplace(FLineSegment(midPoint, segmentEnd));
@@ -648,8 +661,8 @@ void UElectricalStreakComponent::GenerateElectricity(FVector start, FVector end,
 		}
 	}
 
-	ThisLifeTime = LifeTime.GetRandom();
-	RespawnAt = ThisLifeTime + PostDelay.GetRandom();
+	ThisLifeTime = LifeTime.GetRandom(Random);
+	RespawnAt = ThisLifeTime + PostDelay.GetRandom(Random);
 	Timer = 0.0f;
 }
 
@@ -865,13 +865,7 @@ void ULightStreakComponent::SetGlobalAmount(float alphaAmount, float lifeTimeAmo
 
 float ULightStreakComponent::Noise(float value) const
 {
-	float height = PerlinNoise.Noise1(value * 0.03125f);
-
-	height += PerlinNoise.Noise1(value * 0.0625f) * 0.5f;
-	height += PerlinNoise.Noise1(value * 0.125f) * 0.25f;
-	height += PerlinNoise.Noise1(value * 0.25f) * 0.125f;
-
-	return height + 0.625f;
+	return PerlinNoise.OctaveNoise1(value) + 0.625f;
 }
 
 #pragma endregion VehicleLightStreaks
@@ -183,7 +183,12 @@ void FPlayerRaceState::UpdateCheckpoints(bool ignoreCheckpointSize)
 			int32 lastCheckPoint = LastCheckpoint;
 			FVector location = PlayerVehicle->GetActorLocation();
 
-			do
+			// Each checkpoint crossed has its distance along the master racing spline between the last
+			// distance and this one, and no checkpoint can be crossed more than once, so the number of
+			// checkpoints in that range bounds the number of crossings. Most frames there won't be any
+			// at all, and so no checkpoints will need to be tested.
+
+			for (int32 numCandidates = gameMode->NumCheckpointsBetween(LastDistanceAlongMasterRacingSpline, DistanceAlongMasterRacingSpline, crossedSplineStart); numCandidates > 0; numCandidates--)
 			{
 				// Have we crossed the next checkpoint, effectively going forwards?
 
@@ -191,7 +196,7 @@ void FPlayerRaceState::UpdateCheckpoints(bool ignoreCheckpointSize)
 
 				// Have we crossed the last checkpoint, effectively going backwards?
 
-				int32 crossed1 = gameMode->Checkpoints[LastCheckpoint]->Crossed(LastDistanceAlongMasterRacingSpline, DistanceAlongMasterRacingSpline, masterRacingSplineLength, crossedSplineStart, PlayerVehicle->GetAI().LastLocation, location, ignoreCheckpointSize);
+				int32 crossed1 = (crossed0 > 0) ? 0 : gameMode->Checkpoints[LastCheckpoint]->Crossed(LastDistanceAlongMasterRacingSpline, DistanceAlongMasterRacingSpline, masterRacingSplineLength, crossedSplineStart, PlayerVehicle->GetAI().LastLocation, location, ignoreCheckpointSize);
 
 				if (crossed0 > 0)
 				{
@@ -269,12 +274,16 @@ void FPlayerRaceState::UpdateCheckpoints(bool ignoreCheckpointSize)
 					break;
 				}
 
-				// while loop to catch large jumps in position due to teleporting and wind through all
+				// Loop to catch large jumps in position due to teleporting and wind through all
 				// checkpoints that may have been crossed because of that. Don't jump more than 1 lap
 				// forwards or backwards though, no matter how large the jump in position is. It's
 				// highly unlikely we'll cross more than one checkpoint in a frame in any event.
+
+				if (lastCheckPoint == LastCheckpoint)
+				{
+					break;
+				}
 			}
-			while (lastCheckPoint != LastCheckpoint);
 
 			if (EternalLapNumber >= 0)
 			{
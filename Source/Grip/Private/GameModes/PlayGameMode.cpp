@@ -26,6 +26,7 @@
 #include "components/image.h"
 #include "camera/statictrackcamera.h"
 #include "ui/hudwidget.h"
+#include "algo/binarysearch.h"
 
 /**
 * APlayGameMode statics.
@@ -199,7 +200,13 @@ int32 APlayGameMode::CalculateMaxPlayers() const
 {
 	int32 maxPlayers = FMath::Min(GlobalGameState->GeneralOptions.NumberOfPlayers, Startpoints.Num());
 
-	if (GameStateOverrides != nullptr &&
+	if (FGridBenchmark::IsActive() == true)
+	{
+		// The grid benchmark ignores the options and overrides and just fills the grid.
+
+		maxPlayers = FMath::Min(FGridBenchmark::GetNumVehicles(), Startpoints.Num());
+	}
+	else if (GameStateOverrides != nullptr &&
 		GameStateOverrides->OverrideGrid == true)
 	{
 		maxPlayers = FMath::Min(maxPlayers, GameStateOverrides->Grid.Num() + GlobalGameState->TransientGameState.NumberOfLocalPlayers);
@@ -308,6 +315,7 @@ void APlayGameMode::BeginPlay()
 	// Record all of the checkpoints in the level.
 
 	Checkpoints.Empty();
+	CheckpointDistances.Empty();
 
 	for (TActorIterator<ATrackCheckpoint> actorItr(world); actorItr; ++actorItr)
 	{
@@ -374,6 +382,16 @@ void APlayGameMode::BeginPlay()
 			}
 
 			MasterRacingSplineStartDistance = Checkpoints[0]->DistanceAlongMasterRacingSpline;
+
+			// Keep the checkpoint distances sorted so that the ones crossed by a vehicle can
+			// be found with a binary search rather than testing them one at a time.
+
+			for (ATrackCheckpoint* checkpoint : Checkpoints)
+			{
+				CheckpointDistances.Emplace(checkpoint->DistanceAlongMasterRacingSpline);
+			}
+
+			CheckpointDistances.Sort();
 		}
 	}
 
@@ -382,6 +400,8 @@ void APlayGameMode::BeginPlay()
 	int32 index = 0;
 
 	Vehicles.Empty();
+	RaceDistanceOrder.Empty();
+	EternalRaceDistanceOrder.Empty();
 
 	// Setup all the vehicles that have already been created in the menu UI
 	// (all local players normally).
@@ -527,6 +547,19 @@ void APlayGameMode::BeginPlay()
 		}
 	}
 
+	for (AActor* actor : FrictionalActors)
+	{
+		AddContactPolicy(actor, FActorContactPolicy(EActorContactPolicy::Frictional));
+	}
+
+	// The contact policies are read on the physics thread without locking, so changes to
+	// them are only published at the start of each frame, before the physics runs and
+	// after any destroyed actors they refer to have been unregistered.
+
+	PublishContactPoliciesHandle = FWorldDelegates::OnWorldPreActorTick.AddUObject(this, &APlayGameMode::PublishContactPolicies);
+
+	PublishContactPolicies(GetWorld(), LEVELTICK_All, 0.0f);
+
 #pragma region CameraCinematics
 
 	// Record all of the track cameras in the level.
@@ -562,9 +595,31 @@ void APlayGameMode::EndPlay(const EEndPlayReason::Type endPlayReason)
 
 	ChangeTimeDilation(1.0f, 0.0f);
 
+	FWorldDelegates::OnWorldPreActorTick.Remove(PublishContactPoliciesHandle);
+
+	PendingContactPolicies.Empty();
+	ContactPolicies.Empty();
+
+	ActorPool.StopMeasuring(GetWorld());
+
 	Super::EndPlay(endPlayReason);
 }
 
+/**
+* Publish the contact policies changed on the game thread for the physics thread to
+* read.
+***********************************************************************************/
+
+void APlayGameMode::PublishContactPolicies(UWorld* world, ELevelTick tickType, float deltaSeconds)
+{
+	if (world == GetWorld() &&
+		ContactPoliciesChanged == true)
+	{
+		ContactPolicies = PendingContactPolicies;
+		ContactPoliciesChanged = false;
+	}
+}
+
 /**
 * Determine the vehicles that are currently present in the level.
 ***********************************************************************************/
@@ -572,10 +627,14 @@ void APlayGameMode::EndPlay(const EEndPlayReason::Type endPlayReason)
 void APlayGameMode::DetermineVehicles()
 {
 	Vehicles.Empty();
+	RaceDistanceOrder.Empty();
+	EternalRaceDistanceOrder.Empty();
 
 	for (TActorIterator<ABaseVehicle> actorItr(GetWorld()); actorItr; ++actorItr)
 	{
 		Vehicles.Emplace(*actorItr);
+
+		AddContactPolicy(*actorItr, FActorContactPolicy(EActorContactPolicy::Vehicle, *actorItr));
 	}
 
 	// Sort the vehicles by vehicle index, not strictly necessary, but this could
@@ -1009,6 +1068,16 @@ void APlayGameMode::Tick(float deltaSeconds)
 
 	FrameTimes.AddValue(GetRealTimeClock(), deltaSeconds);
 
+	// Take the frame snapshots of all the vehicles at once, now they've all ticked, so
+	// that everything reading them sees the same frame no matter the tick order.
+
+	UpdateVehicleSnapshots();
+
+	// Build the vehicle broadphase once for the frame, for everything that follows and
+	// for the vehicles on the next frame.
+
+	VehicleBroadphase.Build(GetVehicles(), deltaSeconds);
+
 	if (clock == 0.0f)
 	{
 		LastOptionsResetTime = clock;
@@ -1039,6 +1108,10 @@ void APlayGameMode::Tick(float deltaSeconds)
 	switch (GameSequence)
 	{
 	case EGameSequence::Initialise:
+		PrewarmActorPool();
+
+		ActorPool.StartMeasuring();
+
 		GameSequence = EGameSequence::Start;
 
 		// We purposefully don't break here to do the Start immediately.
@@ -1065,6 +1138,132 @@ void APlayGameMode::Tick(float deltaSeconds)
 
 #pragma endregion VehicleAudio
 
+	UpdateSpatialIndices();
+
+	UpdateCombatAffinities();
+
+	ThreatRegistry.Update(Missiles);
+
+	UpdateAIWorkScheduler(deltaSeconds);
+
+	VisibilityQueryService.Tick();
+
+	GunRoundManager.Tick();
+
+	UAdvancedMovementComponent::UpdateTerrainProbeStats();
+
+	if (FGridBenchmark::IsActive() == true)
+	{
+		GridBenchmark.Tick(Vehicles.Num(), GameSequence == EGameSequence::Play);
+	}
+}
+
+/**
+* Update the scheduler for the AI work of the vehicles.
+*
+* This is done at the end of the frame, after all of the vehicles have ticked, to
+* schedule their AI work for the next frame.
+***********************************************************************************/
+
+void APlayGameMode::UpdateAIWorkScheduler(float deltaSeconds)
+{
+	if (UGameplayStatics::IsGamePaused(GetWorld()) == true)
+	{
+		return;
+	}
+
+	TArray<ABaseVehicle*>& vehicles = GetVehicles();
+
+	// Get a list of local player camera locations, and the number of vehicle indices.
+
+	int32 numVehicles = 0;
+	TArray<FVector, TInlineAllocator<4>> cameraLocations;
+
+	for (ABaseVehicle* vehicle : vehicles)
+	{
+		numVehicles = FMath::Max(numVehicles, vehicle->GetVehicleIndex() + 1);
+
+		if (vehicle->LocalPlayerIndex >= 0)
+		{
+			FMinimalViewInfo desiredView;
+
+			vehicle->Camera->GetCameraViewNoPostProcessing(0.0f, desiredView);
+
+			cameraLocations.Emplace(desiredView.Location);
+		}
+	}
+
+	AIWorkScheduler.SetNumVehicles(numVehicles);
+
+	for (ABaseVehicle* vehicle : vehicles)
+	{
+		float cameraDistance = BIG_NUMBER;
+		FVector location = vehicle->GetCenterLocation();
+
+		for (const FVector& cameraLocation : cameraLocations)
+		{
+			cameraDistance = FMath::Min(cameraDistance, (cameraLocation - location).Size());
+		}
+
+		AIWorkScheduler.SetVehicleState(vehicle->GetVehicleIndex(), cameraDistance, vehicle->GetRaceState().RacePosition);
+	}
+
+	AIWorkScheduler.Tick(deltaSeconds);
+}
+
+/**
+* Get the proximity broadphase for vehicle-to-vehicle queries.
+*
+* This is normally built at the end of each frame, but is built here on demand if
+* the vehicles have changed since then, or it's needed before the first build.
+***********************************************************************************/
+
+const FVehicleBroadphase& APlayGameMode::GetVehicleBroadphase()
+{
+	TArray<ABaseVehicle*>& vehicles = GetVehicles();
+
+	if (VehicleBroadphase.Num() != vehicles.Num())
+	{
+		VehicleBroadphase.Build(vehicles, GetWorld()->GetDeltaSeconds());
+	}
+
+	return VehicleBroadphase;
+}
+
+/**
+* Update the frame snapshots of all of the vehicles.
+*
+* This is done at the end of the frame, after all of the vehicles have ticked, so
+* during a frame the snapshots always describe the end of the last one, for every
+* reader and regardless of the order in which the actors tick.
+***********************************************************************************/
+
+void APlayGameMode::UpdateVehicleSnapshots()
+{
+	for (ABaseVehicle* vehicle : GetVehicles())
+	{
+		vehicle->UpdateFrameSnapshot();
+	}
+}
+
+/**
+* Update the spatial indices of the attractables and avoidables.
+*
+* Objects are only re-indexed against the master racing spline when they move, so
+* this is cheap for the static objects that make up the bulk of them.
+***********************************************************************************/
+
+void APlayGameMode::UpdateSpatialIndices()
+{
+	const UAdvancedSplineComponent* spline = (GRIP_POINTER_VALID(MasterRacingSpline) == true) ? MasterRacingSpline.Get() : nullptr;
+
+	AttractablesIndex.Update(spline,
+		[] (const IAttractableInterface* attractable) { return attractable->GetAttractionLocation(); },
+		[] (const IAttractableInterface* attractable) { return attractable->GetAttractionDistanceRange(); });
+
+	AvoidablesIndex.Update(spline,
+		[] (const IAvoidableInterface* avoidable) { return avoidable->GetAvoidanceLocation(); },
+		[] (const IAvoidableInterface* avoidable) { return avoidable->GetAvoidanceRadius(); });
 }
 
 /**
@@ -1098,6 +1297,66 @@ void APlayGameMode::QuitGame(bool force)
 {
 }
 
+/**
+* Sort an array into order with an insertion sort, which is linear for an array
+* that is already nearly in order.
+*
+* This is stable, but relies on the comparison being a strict total order for the
+* result not to depend on the order the array was in beforehand.
+***********************************************************************************/
+
+template <typename ElementType, typename PredicateType>
+static void InsertionSort(TArray<ElementType>& elements, PredicateType predicate)
+{
+	for (int32 i = 1; i < elements.Num(); i++)
+	{
+		ElementType element = elements[i];
+		int32 j = i;
+
+		for (; j > 0 && predicate(element, elements[j - 1]) == true; j--)
+		{
+			elements[j] = elements[j - 1];
+		}
+
+		elements[j] = element;
+	}
+}
+
+/**
+* Repair the orders of the race states held between frames.
+*
+* Race positions rarely change by more than a swap or two from one frame to the
+* next, so rather than gathering and sorting the race states from scratch every
+* frame, the orders from the last frame are repaired with an insertion sort.
+* Vehicles are held in vehicle index order, and ties are broken by vehicle index,
+* so the orders are identical to those of a stable sort of the vehicles.
+***********************************************************************************/
+
+void APlayGameMode::UpdateRaceOrders()
+{
+	if (RaceDistanceOrder.Num() != Vehicles.Num())
+	{
+		RaceDistanceOrder.Reset();
+		EternalRaceDistanceOrder.Reset();
+
+		for (ABaseVehicle* vehicle : Vehicles)
+		{
+			RaceDistanceOrder.Emplace(&vehicle->GetRaceState());
+			EternalRaceDistanceOrder.Emplace(&vehicle->GetRaceState());
+		}
+	}
+
+	InsertionSort(RaceDistanceOrder, [] (const FPlayerRaceState* object1, const FPlayerRaceState* object2)
+		{
+			if (object1->RaceDistance == object2->RaceDistance) return object1->PlayerVehicle->VehicleIndex < object2->PlayerVehicle->VehicleIndex; else return object1->RaceDistance > object2->RaceDistance;
+		});
+
+	InsertionSort(EternalRaceDistanceOrder, [] (const FPlayerRaceState* object1, const FPlayerRaceState* object2)
+		{
+			if (object1->EternalRaceDistance == object2->EternalRaceDistance) return object1->PlayerVehicle->VehicleIndex < object2->PlayerVehicle->VehicleIndex; else return object1->EternalRaceDistance > object2->EternalRaceDistance;
+		});
+}
+
 /**
 * Calculate the race positions for each of the vehicles.
 ***********************************************************************************/
@@ -1123,20 +1382,15 @@ void APlayGameMode::UpdateRacePositions(float deltaSeconds)
 
 	// Calculate the mean race distance of the human players in the race.
 
-	int32 i = 0;
 	int32 numHumans = 0;
 	int32 firstRacePosition = 0;
 	float meanHumanDistance = 0.0f;
 
-	TArray<FPlayerRaceState*, TInlineAllocator<16>> raceStates;
+	UpdateRaceOrders();
 
 	for (ABaseVehicle* vehicle : Vehicles)
 	{
-		if (vehicle->GetRaceState().PlayerCompletionState < EPlayerCompletionState::Complete)
-		{
-			raceStates.Emplace(&vehicle->GetRaceState());
-		}
-		else if (vehicle->GetRaceState().PlayerCompletionState == EPlayerCompletionState::Complete)
+		if (vehicle->GetRaceState().PlayerCompletionState == EPlayerCompletionState::Complete)
 		{
 			firstRacePosition = FMath::Max(firstRacePosition, vehicle->GetRaceState().RacePosition + 1);
 		}
@@ -1174,52 +1428,35 @@ void APlayGameMode::UpdateRacePositions(float deltaSeconds)
 		GameSequence == EGameSequence::Play)
 	{
 		GameSequence = EGameSequence::End;
-	}
 
-	if (raceStates.Num() > 0)
-	{
-		// Calculate the race position for each player.
+		ActorPool.StopMeasuring(GetWorld());
+	}
 
-		raceStates.StableSort([] (const FPlayerRaceState& object1, const FPlayerRaceState& object2)
-			{
-				if (object1.RaceDistance == object2.RaceDistance) return object1.PlayerVehicle->VehicleIndex < object2.PlayerVehicle->VehicleIndex; else return object1.RaceDistance > object2.RaceDistance;
-			});
+	// Calculate the race position for each player still racing, in race distance order.
 
-		for (i = 0; i < raceStates.Num(); i++)
+	for (FPlayerRaceState* raceState : RaceDistanceOrder)
+	{
+		if ((raceState->PlayerCompletionState < EPlayerCompletionState::Complete) &&
+			(raceState->RaceDistance != 0.0f || GlobalGameState->GamePlaySetup.DrivingMode == EDrivingMode::Elimination))
 		{
-			if ((raceStates[i]->PlayerCompletionState < EPlayerCompletionState::Complete) &&
-				(raceStates[i]->RaceDistance != 0.0f || GlobalGameState->GamePlaySetup.DrivingMode == EDrivingMode::Elimination))
-			{
-				raceStates[i]->RacePosition = FMath::Min(firstRacePosition++, GRIP_MAX_PLAYERS - 1);
-			}
+			raceState->RacePosition = FMath::Min(firstRacePosition++, FMath::Max(Vehicles.Num(), 1) - 1);
 		}
 	}
 
-	raceStates.Empty(GRIP_MAX_PLAYERS);
-
 	if (GameSequence >= EGameSequence::Play)
 	{
-		for (ABaseVehicle* vehicle : Vehicles)
-		{
-			raceStates.Emplace(&vehicle->GetRaceState());
-		}
 
 #pragma region VehicleCatchup
 
-		if (raceStates.Num() > 0)
+		if (EternalRaceDistanceOrder.Num() > 0)
 		{
 			// Now calculate the auto-catchup assistance.
 
-			raceStates.StableSort([] (const FPlayerRaceState& object1, const FPlayerRaceState& object2)
-				{
-					return object1.EternalRaceDistance > object2.EternalRaceDistance;
-				});
-
 			FVehicleCatchupCharacteristics& characteristics = GetDifficultyCharacteristics().VehicleCatchupCharacteristics;
 
 			// Pick the median race distance for all of the players in the race.
 
-			float median = raceStates[raceStates.Num() >> 1]->EternalRaceDistance;
+			float median = EternalRaceDistanceOrder[EternalRaceDistanceOrder.Num() >> 1]->EternalRaceDistance;
 
 			if (numHumans == 0)
 			{
@@ -1500,20 +1737,13 @@ struct FNameTagSorter
 };
 
 /**
-* Find a name tag structure for a given index.
+* Find a name tag structure for a given index, using a lookup of the positions of
+* the name tags by index.
 ***********************************************************************************/
 
-static FNameTagSorter* FindNameTagForIndex(TArray<FNameTagSorter>& nameTags, int32 index)
+static FNameTagSorter* FindNameTagForIndex(TArray<FNameTagSorter>& nameTags, const TArray<int32>& lookup, int32 index)
 {
-	for (FNameTagSorter& nameTag : nameTags)
-	{
-		if (nameTag.Index == index)
-		{
-			return &nameTag;
-		}
-	}
-
-	return nullptr;
+	return (lookup.IsValidIndex(index) == true && lookup[index] != INDEX_NONE) ? &nameTags[lookup[index]] : nullptr;
 }
 
 /**
@@ -1672,6 +1902,17 @@ void APlayGameMode::UpdatePlayerTags(APawn* owningPawn, UPanelWidget* parent)
 			}
 		}
 
+		// Index the name tags by vehicle so they can be found directly.
+
+		TArray<int32> nameTagLookup;
+
+		nameTagLookup.Init(INDEX_NONE, Vehicles.Num());
+
+		for (int32 i = 0; i < nameTags.Num(); i++)
+		{
+			nameTagLookup[nameTags[i].Index] = i;
+		}
+
 		// Update the visual components associated with the name tags.
 
 		arenaIndex = 0;
@@ -1689,7 +1930,7 @@ void APlayGameMode::UpdatePlayerTags(APawn* owningPawn, UPanelWidget* parent)
 
 				ESlateVisibility visible = ESlateVisibility::Collapsed;
 				int32 vehicleIndex = arenaIndex++;
-				FNameTagSorter* nameTag = FindNameTagForIndex(nameTags, vehicleIndex);
+				FNameTagSorter* nameTag = FindNameTagForIndex(nameTags, nameTagLookup, vehicleIndex);
 
 				if (nameTag != nullptr &&
 					nameTag->Opacity > 0.0f)
@@ -1733,7 +1974,7 @@ void APlayGameMode::UpdatePlayerTags(APawn* owningPawn, UPanelWidget* parent)
 
 				ESlateVisibility visible = ESlateVisibility::Collapsed;
 				int32 vehicleIndex = playerIndex++;
-				FNameTagSorter* nameTag = FindNameTagForIndex(nameTags, vehicleIndex);
+				FNameTagSorter* nameTag = FindNameTagForIndex(nameTags, nameTagLookup, vehicleIndex);
 
 				if (nameTag != nullptr &&
 					nameTag->Opacity > 0.0f)
@@ -1858,6 +2099,11 @@ AActor* APlayGameMode::ChoosePlayerStartProperly(AController* player, int32 maxP
 				}
 			}
 		}
+
+		if (FGridBenchmark::GetNumVehicles() > Startpoints.Num())
+		{
+			AddBenchmarkStartpoints(FGridBenchmark::GetNumVehicles());
+		}
 	}
 
 	if (maxPlayers == 0)
@@ -1899,6 +2145,82 @@ AActor* APlayGameMode::ChoosePlayerStartProperly(AController* player, int32 maxP
 	return nullptr;
 }
 
+/**
+* Add player starts behind the existing grid so that there's room for a grid
+* benchmark.
+*
+* The existing grid is replicated backwards as many times as necessary, each copy
+* placed a little behind the last and dropped onto the ground at the same height
+* above it as the start it was copied from.
+***********************************************************************************/
+
+void APlayGameMode::AddBenchmarkStartpoints(int32 numStartpoints)
+{
+	TArray<APlayerStart*> grid;
+
+	for (APlayerStart* playerStart : UnusedStartpoints)
+	{
+		if (playerStart->IsA<APlayerStartPIE>() == false)
+		{
+			grid.Emplace(playerStart);
+		}
+	}
+
+	if (grid.Num() == 0)
+	{
+		return;
+	}
+
+	UWorld* world = GetWorld();
+	FVector forward = grid[0]->GetActorRotation().Vector();
+	float minDistance = 0.0f;
+	float maxDistance = 0.0f;
+
+	for (int32 i = 0; i < grid.Num(); i++)
+	{
+		float distance = FVector::DotProduct(grid[i]->GetActorLocation(), forward);
+
+		minDistance = (i == 0) ? distance : FMath::Min(minDistance, distance);
+		maxDistance = (i == 0) ? distance : FMath::Max(maxDistance, distance);
+	}
+
+	float gridLength = (maxDistance - minDistance) + (10.0f * 100.0f);
+
+	FActorSpawnParameters spawnParams;
+
+	spawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+
+	FCollisionQueryParams queryParams(TEXT("BenchmarkStart"), false);
+
+	for (int32 i = 0; Startpoints.Num() < numStartpoints; i++)
+	{
+		APlayerStart* source = grid[i % grid.Num()];
+		FVector location = source->GetActorLocation();
+		FVector up = source->GetActorRotation().RotateVector(FVector::UpVector);
+		FVector offset = forward * -gridLength * ((i / grid.Num()) + 1);
+		FHitResult sourceHit;
+		FHitResult hit;
+
+		// Keep the new start at the same height above the ground as its source.
+
+		if (world->LineTraceSingleByChannel(sourceHit, location, location - up * (50.0f * 100.0f), ECC_WorldStatic, queryParams) == true &&
+			world->LineTraceSingleByChannel(hit, location + offset + up * (50.0f * 100.0f), location + offset - up * (50.0f * 100.0f), ECC_WorldStatic, queryParams) == true)
+		{
+			offset = (hit.ImpactPoint - sourceHit.ImpactPoint);
+		}
+
+		APlayerStart* playerStart = world->SpawnActor<APlayerStart>(APlayerStart::StaticClass(), location + offset, source->GetActorRotation(), spawnParams);
+
+		if (playerStart == nullptr)
+		{
+			break;
+		}
+
+		Startpoints.Emplace(playerStart);
+		UnusedStartpoints.Emplace(playerStart);
+	}
+}
+
 /**
 * Record an event that has just occurred within the game.
 ***********************************************************************************/
@@ -1964,6 +2286,43 @@ float APlayGameMode::MasterRacingSplineDistanceToLapDistance(float distance)
 	}
 }
 
+/**
+* Get the number of checkpoints that might be crossed moving between two master
+* racing spline distances.
+*
+* This is a conservative count for ATrackCheckpoint::Crossed, which puts the
+* distances into the same frame of reference when the spline start has been
+* crossed. The range is padded a little so that rounding differences can only
+* ever add candidates, never lose them.
+***********************************************************************************/
+
+int32 APlayGameMode::NumCheckpointsBetween(float fromDistance, float toDistance, bool crossedSplineStart) const
+{
+	if (CheckpointDistances.Num() != Checkpoints.Num())
+	{
+		// Without the sorted distances, every checkpoint has to be considered.
+
+		return Checkpoints.Num();
+	}
+
+	const float tolerance = 1.0f;
+	float minDistance = FMath::Min(fromDistance, toDistance);
+	float maxDistance = FMath::Max(fromDistance, toDistance);
+
+	if (crossedSplineStart == false)
+	{
+		return Algo::UpperBound(CheckpointDistances, maxDistance + tolerance) - Algo::LowerBound(CheckpointDistances, minDistance - tolerance);
+	}
+	else
+	{
+		// The distances are on opposing sides of the spline start, so the range wraps
+		// around it, from the larger distance to the end of the spline and then from
+		// the start of the spline to the smaller distance.
+
+		return (CheckpointDistances.Num() - Algo::LowerBound(CheckpointDistances, maxDistance - tolerance)) + Algo::UpperBound(CheckpointDistances, minDistance + tolerance);
+	}
+}
+
 /**
 * Project a point in world space for use on the HUD.
 ***********************************************************************************/
@@ -2381,32 +2740,6 @@ float APlayGameMode::GetHUDScale() const
 
 }
 
-#pragma region VehiclePhysicsTweaks
-
-#if GRIP_ANTI_SKYWARD_LAUNCH
-
-/**
-* Should an actor actively limit the collision response when a vehicle collides
-* with it?
-***********************************************************************************/
-
-bool APlayGameMode::ShouldActorLimitCollisionResponse(AActor* actor)
-{
-	if (actor == LastFrictionalActorCheck.Get())
-	{
-		return LastFrictionalActorCheckResult;
-	}
-
-	LastFrictionalActorCheck = actor;
-	LastFrictionalActorCheckResult = FrictionalActors.Contains(actor);
-
-	return LastFrictionalActorCheckResult;
-}
-
-#endif // GRIP_ANTI_SKYWARD_LAUNCH
-
-#pragma endregion VehiclePhysicsTweaks
-
 #pragma region VehicleAudio
 
 /**
@@ -2471,11 +2804,25 @@ void APlayGameMode::UpdateVehicleVolumes(float deltaSeconds)
 		{
 			if (vehicle->IsVehicleDestroyed() == false)
 			{
-				// Find the shortest distance to one of the player cameras.
-
 				vehicle->GlobalVolumeRatio = 0.0f;
 
-				for (FVector& location : localPositions)
+				volumeVehicles.Emplace(vehicle);
+			}
+		}
+
+		// Find the shortest distance to one of the player cameras. Vehicles beyond the max
+		// volume distance from every camera have no volume, so we only need to look at the
+		// vehicles within that distance of each camera.
+
+		FVehicleBroadphase::FVehicleList nearbyVehicles;
+
+		for (FVector& location : localPositions)
+		{
+			VehicleBroadphase.QueryNeighbours(location, MaxVehicleVolumeDistance, nearbyVehicles);
+
+			for (ABaseVehicle* vehicle : nearbyVehicles)
+			{
+				if (vehicle->IsVehicleDestroyed() == false)
 				{
 					// Normalize the distance of the vehicle between the min and max volume distances.
 
@@ -2484,8 +2831,6 @@ void APlayGameMode::UpdateVehicleVolumes(float deltaSeconds)
 
 					vehicle->GlobalVolumeRatio = FMath::Max(vehicle->GlobalVolumeRatio, volume);
 				}
-
-				volumeVehicles.Emplace(vehicle);
 			}
 		}
 
@@ -2702,9 +3047,40 @@ int32 APlayGameMode::GetPlayerRacePickupIndex(ABaseVehicle* vehicle)
 * -1 means no, 0 means yes, +1 means hell yeah!
 *
 * This generated from the playgamemode weapon use data.
+*
+* This is asked for every launcher and target pair during target selection, so
+* it's normally read from the combat affinities calculated at the end of the last
+* frame, which is when the race positions it's based upon were last updated.
 ***********************************************************************************/
 
 float APlayGameMode::VehicleShouldFightVehicle(ABaseVehicle* aggressor, ABaseVehicle* victim)
+{
+	if (aggressor == nullptr ||
+		aggressor->HasAIDriver() == false)
+	{
+		// This is a human player, let them do what they want.
+
+		return 0.0f;
+	}
+
+	int32 aggressorIndex = aggressor->GetVehicleIndex();
+	int32 victimIndex = (victim != nullptr) ? victim->GetVehicleIndex() : INDEX_NONE;
+
+	if (CombatAffinities.IsValidIndex(aggressorIndex) == true &&
+		(victim == nullptr || CombatAffinities.IsValidIndex(victimIndex) == true))
+	{
+		return CombatAffinities.GetAffinity(aggressorIndex, victimIndex);
+	}
+
+	return CalculateVehicleShouldFightVehicle(aggressor, victim);
+}
+
+/**
+* Calculate whether a vehicle should be fighting another vehicle, ignoring the
+* combat affinities.
+***********************************************************************************/
+
+float APlayGameMode::CalculateVehicleShouldFightVehicle(ABaseVehicle* aggressor, ABaseVehicle* victim)
 {
 	// Handle the simple cases first.
 
@@ -2788,6 +3164,88 @@ float APlayGameMode::VehicleShouldFightVehicle(ABaseVehicle* aggressor, ABaseVeh
 	return result;
 }
 
+/**
+* Update the combat affinities of all the vehicles against each other.
+*
+* This is done at the end of the frame, after the race positions have been
+* updated, for the vehicles to use during the next frame.
+***********************************************************************************/
+
+void APlayGameMode::UpdateCombatAffinities()
+{
+	TArray<ABaseVehicle*>& vehicles = GetVehicles();
+
+	int32 numVehicles = 0;
+
+	for (ABaseVehicle* vehicle : vehicles)
+	{
+		numVehicles = FMath::Max(numVehicles, vehicle->GetVehicleIndex() + 1);
+	}
+
+	CombatAffinities.Reset(numVehicles);
+
+	NumLiveHumanVehicles = 0;
+
+	for (ABaseVehicle* vehicle : vehicles)
+	{
+		FVehicleCombatFlags flags;
+
+		flags.CanBeAttacked = vehicle->CanBeAttacked();
+		flags.IsGoodForSmacking = vehicle->IsGoodForSmacking();
+		flags.HasAIDriver = vehicle->HasAIDriver();
+		flags.IsAIVehicle = vehicle->IsAIVehicle();
+
+		CombatAffinities.SetFlags(vehicle->GetVehicleIndex(), flags);
+
+		if (flags.IsAIVehicle == false &&
+			vehicle->IsVehicleDestroyed() == false)
+		{
+			NumLiveHumanVehicles++;
+		}
+	}
+
+	for (ABaseVehicle* aggressor : vehicles)
+	{
+		if (aggressor->HasAIDriver() == true)
+		{
+			// Human players are always left with an affinity of 0, so only bots need filling in.
+
+			int32 aggressorIndex = aggressor->GetVehicleIndex();
+
+			CombatAffinities.SetAffinity(aggressorIndex, INDEX_NONE, CalculateVehicleShouldFightVehicle(aggressor, nullptr));
+
+			for (ABaseVehicle* victim : vehicles)
+			{
+				CombatAffinities.SetAffinity(aggressorIndex, victim->GetVehicleIndex(), CalculateVehicleShouldFightVehicle(aggressor, victim));
+			}
+		}
+	}
+}
+
+/**
+* Get the combat flags for a vehicle, as of the last update of the combat
+* affinities.
+***********************************************************************************/
+
+FVehicleCombatFlags APlayGameMode::GetVehicleCombatFlags(ABaseVehicle* vehicle) const
+{
+	int32 vehicleIndex = vehicle->GetVehicleIndex();
+
+	if (CombatAffinities.IsValidIndex(vehicleIndex) == true)
+	{
+		return CombatAffinities.GetFlags(vehicleIndex);
+	}
+
+	FVehicleCombatFlags flags;
+
+	flags.CanBeAttacked = vehicle->CanBeAttacked();
+	flags.IsGoodForSmacking = vehicle->IsGoodForSmacking();
+	flags.HasAIDriver = vehicle->HasAIDriver();
+	flags.IsAIVehicle = vehicle->IsAIVehicle();
+
+	return flags;
+}
+
 /**
 * Should a pickup be used?
 *
@@ -2899,3 +3357,39 @@ int32 APlayGameMode::NumPickupsPresent(EPickupType pickupType)
 }
 
 #pragma endregion VehiclePickups
+
+/**
+* Pre-warm the actor pool with the pickups and effects the game is likely to need.
+*
+* Each vehicle can only have one turbo and one gun in use at a time, and each
+* pickup pad only has one effect, so having this many free in the pool means we
+* shouldn't need to spawn any of them during the game. Charged pickups are less
+* common so we only pre-warm half as many of those.
+***********************************************************************************/
+
+void APlayGameMode::PrewarmActorPool()
+{
+	UWorld* world = GetWorld();
+	int32 numVehicles = Vehicles.Num();
+	int32 numChargedVehicles = (numVehicles + 1) >> 1;
+
+	ActorPool.Prewarm(world, ABaseVehicle::Level1TurboBlueprint, numVehicles);
+	ActorPool.Prewarm(world, ABaseVehicle::Level2TurboBlueprint, numChargedVehicles);
+	ActorPool.Prewarm(world, ABaseVehicle::Level1GatlingGunBlueprint, numVehicles);
+	ActorPool.Prewarm(world, ABaseVehicle::Level2GatlingGunBlueprint, numChargedVehicles);
+
+	TMap<UClass*, int32> numEffects;
+
+	for (TActorIterator<APickup> actorItr(world); actorItr; ++actorItr)
+	{
+		if (actorItr->Effect != nullptr)
+		{
+			numEffects.FindOrAdd(actorItr->Effect)++;
+		}
+	}
+
+	for (const TPair<UClass*, int32>& effect : numEffects)
+	{
+		ActorPool.Prewarm(world, effect.Key, effect.Value);
+	}
+}
@@ -14,6 +14,19 @@
 
 #include "pickups/advancedmovementcomponent.h"
 #include "gamemodes/basegamemode.h"
+#include "ai/pursuitsplinecomponent.h"
+
+DEFINE_STAT(STAT_TerrainProbes);
+DEFINE_STAT(STAT_TerrainProbesFromSplines);
+DEFINE_STAT(STAT_TerrainTracesSaved);
+
+static TAutoConsoleVariable<int32> CVarSplineTerrainProbes(
+	TEXT("grip.SplineTerrainProbes"),
+	1,
+	TEXT("Answer projectile terrain probes from pursuit spline clearance data where possible.\n")
+	TEXT("  0: Off, always trace\n")
+	TEXT("  1: On"),
+	ECVF_Default);
 
 /**
 * Construct an advanced movement component.
@@ -31,6 +44,9 @@ UAdvancedMovementComponent::UAdvancedMovementComponent()
 
 const float UAdvancedMovementComponent::MinimumTickTime = 0.0002f;
 
+int32 UAdvancedMovementComponent::NumTerrainProbes = 0;
+int32 UAdvancedMovementComponent::NumTerrainProbesFromSplines = 0;
+
 /**
 * Initialize the component.
 ***********************************************************************************/
@@ -316,7 +332,7 @@ bool UAdvancedMovementComponent::AvoidTerrain(float deltaSeconds, float terrainA
 
 		// TODO: More casts to avoid terrain close to the current projectile location.
 
-		if (GetWorld()->LineTraceSingleByChannel(hitResult, projectileLocation, end, ABaseGameMode::ECC_TerrainFollowing, TerrainQueryParams) == true)
+		if (ProbeTerrain(hitResult, projectileLocation, end, ABaseGameMode::ECC_TerrainFollowing, TerrainQueryParams) == true)
 		{
 			// So this is where we want to be above the ground.
 
@@ -343,6 +359,159 @@ bool UAdvancedMovementComponent::AvoidTerrain(float deltaSeconds, float terrainA
 	return result;
 }
 
+/**
+* Set the pursuit spline whose clearance data is used to answer terrain probes, and
+* the distance along it that the projectile is at.
+***********************************************************************************/
+
+void UAdvancedMovementComponent::SetTerrainSpline(UPursuitSplineComponent* spline, float distance)
+{
+	TerrainSpline = spline;
+	TerrainSplineDistance = distance;
+
+	if (GRIP_OBJECT_VALID(UpdatedComponent) == true)
+	{
+		TerrainSplineLocation = UpdatedComponent->GetComponentLocation();
+	}
+	else if (spline != nullptr)
+	{
+		TerrainSplineLocation = spline->GetWorldLocationAtDistanceAlongSpline(distance);
+	}
+}
+
+/**
+* Update the distance along the terrain spline from the projectile's location.
+***********************************************************************************/
+
+void UAdvancedMovementComponent::UpdateTerrainSpline(const FVector& location)
+{
+	UPursuitSplineComponent* spline = TerrainSpline.Get();
+
+	if (GRIP_OBJECT_VALID(spline) == true)
+	{
+		float movementSize = (location - TerrainSplineLocation).Size();
+
+		if (movementSize > 1.0f)
+		{
+			// Do the same intelligent nearest point detection that the route followers do,
+			// only searching around where we were last time.
+
+			int32 numIterations = 3;
+			float t0 = TerrainSplineDistance - (movementSize * GRIP_SPLINE_MOVEMENT_MULTIPLIER);
+			float t1 = TerrainSplineDistance + (movementSize * GRIP_SPLINE_MOVEMENT_MULTIPLIER);
+
+			TerrainSplineDistance = spline->GetNearestDistance(location, t0, t1, numIterations, spline->GetNumSamplesForRange(t1 - t0, numIterations, 100.0f));
+			TerrainSplineLocation = location;
+		}
+	}
+}
+
+/**
+* Probe for terrain between two points, answering from the terrain spline's
+* clearance data where possible and only tracing when we can't.
+*
+* Returns true if terrain was hit, with hitResult filled in. When answered from the
+* clearance data there is never a hit, as we only trust the clearances when the
+* probe lies comfortably within them.
+***********************************************************************************/
+
+bool UAdvancedMovementComponent::ProbeTerrain(FHitResult& hitResult, const FVector& start, const FVector& end, ECollisionChannel channel, const FCollisionQueryParams& queryParams)
+{
+	NumTerrainProbes++;
+
+	INC_DWORD_STAT(STAT_TerrainProbes);
+
+	if (IsWithinSplineClearance(start, end) == true)
+	{
+		NumTerrainProbesFromSplines++;
+
+		INC_DWORD_STAT(STAT_TerrainProbesFromSplines);
+
+		return false;
+	}
+
+	return GetWorld()->LineTraceSingleByChannel(hitResult, start, end, channel, queryParams);
+}
+
+/**
+* Is a line segment known to be within the open space around the terrain spline,
+* and therefore not hitting any terrain?
+*
+* The pursuit splines store the distance to the environment in 32 directions around
+* them every 10 meters along their length. We sample the segment at about that
+* spacing, convert each sample into spline space and check that it's inside those
+* clearances by a safe margin. If any sample strays outside of the spline's tunnel,
+* or gets close to its boundary, then we can't say and a real trace is needed.
+***********************************************************************************/
+
+bool UAdvancedMovementComponent::IsWithinSplineClearance(const FVector& start, const FVector& end) const
+{
+	UPursuitSplineComponent* spline = TerrainSpline.Get();
+
+	if (CVarSplineTerrainProbes.GetValueOnGameThread() == 0 ||
+		GRIP_OBJECT_VALID(spline) == false)
+	{
+		return false;
+	}
+
+	const int32 maxSamples = 16;
+	const float sampleSpacing = 10.0f * 100.0f;
+	const float margin = 2.0f * 100.0f;
+
+	FVector difference = end - start;
+	int32 numSamples = FMath::Max(1, FMath::CeilToInt(difference.Size() / sampleSpacing));
+
+	if (numSamples > maxSamples)
+	{
+		return false;
+	}
+
+	FVector origin = spline->GetWorldLocationAtDistanceAlongSpline(TerrainSplineDistance);
+	FVector direction = spline->GetDirection(TerrainSplineDistance);
+
+	for (int32 i = 0; i <= numSamples; i++)
+	{
+		FVector location = start + (difference * ((float)i / (float)numSamples));
+		float distance = spline->ClampDistance(TerrainSplineDistance + FVector::DotProduct(location - origin, direction));
+		FVector offset = spline->WorldSpaceToSplineSpace(location, distance, true);
+
+		// If the spline curves away from the sample then our estimate of the distance along
+		// it is poor, so don't trust the clearances there.
+
+		if (FMath::Abs(offset.X) > sampleSpacing)
+		{
+			return false;
+		}
+
+		// Take the minimum clearance over a small arc around the sample's direction from
+		// the spline, as the clearances are only stored for a limited number of directions.
+
+		float radius = FVector2D(offset.Y, offset.Z).Size();
+
+		if (radius + margin >= spline->GetClearance(distance, offset, 30.0f))
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+/**
+* Publish the statistics for the terrain probes made this frame.
+***********************************************************************************/
+
+void UAdvancedMovementComponent::UpdateTerrainProbeStats()
+{
+	if (NumTerrainProbes > 0)
+	{
+		SET_FLOAT_STAT(STAT_TerrainTracesSaved, ((float)NumTerrainProbesFromSplines / (float)NumTerrainProbes) * 100.0f);
+	}
+
+	NumTerrainProbes = 0;
+	NumTerrainProbesFromSplines = 0;
+}
+
 /**
 * Transition from one direction to another clamped to a maximum rate of change in
 * turning rate.
@@ -15,6 +15,7 @@
 #include "vehicle/flippablevehicle.h"
 #include "ui/hudwidget.h"
 #include "gamemodes/basegamemode.h"
+#include "system/targetweights.h"
 
 /**
 * Construct a UGunHostInterface.
@@ -75,6 +76,14 @@ void AGatlingGun::Tick(float deltaSeconds)
 				BarrelSpinAudio->Stop();
 			}
 
+			// Apply the hits of any rounds still being traced, so that they count towards
+			// the points for the gun.
+
+			if (PlayGameMode != nullptr)
+			{
+				PlayGameMode->GetGunRoundManager().FlushRounds(this);
+			}
+
 			if (LaunchVehicle != nullptr)
 			{
 				if (NumPoints > 0)
@@ -149,13 +158,6 @@ void AGatlingGun::Tick(float deltaSeconds)
 					{
 						// Yes, we need to fire a round.
 
-						int32 launchVehicleIndex = -1;
-
-						if (LaunchVehicle != nullptr)
-						{
-							launchVehicleIndex = LaunchVehicle->VehicleIndex;
-						}
-
 						RoundTimer -= invFireRate;
 
 						RoundLocation ^= 1;
@@ -255,146 +257,163 @@ void AGatlingGun::Tick(float deltaSeconds)
 
 						direction.Normalize();
 
-						float time = 0.0f;
 						FVector end = location + (direction * 100.0f * 1000.0f);
 
-						// Let's see if we hit something.
+						// Hand the round to the gun round manager to trace, along with all of the other
+						// rounds fired this frame, it'll call RoundHit when it knows what it hit.
 
-						if (GetCollision(GetWorld(), location, end, time, ignoreTarget) == true)
-						{
-							USoundCue* hitSound = nullptr;
-							TArray<FVector> hitLocations;
-							TArray<UParticleSystem*> hitParticleSystems;
-							EGameSurface surface = EGameSurface::Default;
-							UPrimitiveComponent* hitComponent = HitResult.GetComponent();
-							FVector impactPoint = FMath::Lerp(location, end, time);
-							FRotator impactRotation = HitResult.ImpactNormal.Rotation();
+						PlayGameMode->GetGunRoundManager().FireRound(this, location, end, target, ignoreTarget);
 
-							LastImpact = impactPoint;
+						NumRoundsFired++;
+					}
+				}
+			}
+		}
+	}
+}
 
-							if (HitResult.GetActor()->IsA<ABaseVehicle>() == true)
-							{
-								// Handle the hitting of a vehicle with a round.
+/**
+* Apply the hit of a round fired from the gun, once the gun round manager has
+* traced it.
+***********************************************************************************/
 
-								NumRoundsHitVehicle++;
+void AGatlingGun::RoundHit(const FHitResult& hitResult, const FVector& start, const FVector& end, AActor* target)
+{
+	int32 launchVehicleIndex = -1;
 
-								ABaseVehicle* vehicle = Cast<ABaseVehicle>(HitResult.GetActor());
+	if (LaunchVehicle != nullptr)
+	{
+		launchVehicleIndex = LaunchVehicle->VehicleIndex;
+	}
 
-								if (HitResult.GetActor() == target)
-								{
-									vehicle->ResetAttackTimer();
-								}
+	USoundCue* hitSound = nullptr;
+	TArray<FVector> hitLocations;
+	TArray<UParticleSystem*> hitParticleSystems;
+	EGameSurface surface = EGameSurface::Default;
+	UPrimitiveComponent* hitComponent = hitResult.GetComponent();
+	FVector impactPoint = hitResult.Location;
+	FRotator impactRotation = hitResult.ImpactNormal.Rotation();
 
-								const FTransform& vehicleTransform = vehicle->VehicleMesh->GetComponentTransform();
+	LastImpact = impactPoint;
 
-								// Ask the vehicle to process a bullet round striking it.
+	if (hitResult.GetActor()->IsA<ABaseVehicle>() == true)
+	{
+		// Handle the hitting of a vehicle with a round.
 
-								if (vehicle->BulletRound(RoundForce, HitPoints * ((LaunchVehicle != nullptr) ? LaunchVehicle->GetDamageScale() : 1.0f), launchVehicleIndex, impactPoint, location, IsCharged(), SpinSide) == true)
-								{
-									// We struck the vehicle.
+		NumRoundsHitVehicle++;
 
-									if (LaunchVehicle != nullptr &&
-										LaunchVehicle->IsAccountingClosed() == false)
-									{
-										int32 numPoints = 5;
+		ABaseVehicle* vehicle = Cast<ABaseVehicle>(hitResult.GetActor());
 
-										if (LaunchVehicle->AddPoints(numPoints, true, vehicle, impactPoint) == true)
-										{
-											NumPoints += numPoints;
+		if (hitResult.GetActor() == target)
+		{
+			vehicle->ResetAttackTimer();
+		}
 
-											if (HitVehicles.Find(vehicle) == INDEX_NONE)
-											{
-												HitVehicles.Emplace(vehicle);
-											}
-										}
-									}
+		const FTransform& vehicleTransform = vehicle->VehicleMesh->GetComponentTransform();
 
-									surface = EGameSurface::Vehicle;
-								}
+		// Ask the vehicle to process a bullet round striking it.
 
-#pragma region PickupShield
+		if (vehicle->BulletRound(RoundForce, HitPoints * ((LaunchVehicle != nullptr) ? LaunchVehicle->GetDamageScale() : 1.0f), launchVehicleIndex, impactPoint, start, IsCharged(), SpinSide) == true)
+		{
+			// We struck the vehicle.
 
-								else
-								{
-									// We can assume here that we struck the vehicle's shield.
+			if (LaunchVehicle != nullptr &&
+				LaunchVehicle->IsAccountingClosed() == false)
+			{
+				int32 numPoints = 5;
 
-									surface = EGameSurface::Shield;
-									hitComponent = vehicle->VehicleMesh;
+				if (LaunchVehicle->AddPoints(numPoints, true, vehicle, impactPoint) == true)
+				{
+					NumPoints += numPoints;
 
-									float standardOffset = -300.0f;
-									FVector additionalOffset = vehicle->VehicleShield->RearOffset;
+					if (HitVehicles.Find(vehicle) == INDEX_NONE)
+					{
+						HitVehicles.Emplace(vehicle);
+					}
+				}
+			}
 
-									if (vehicleTransform.InverseTransformPosition(impactPoint).X > 0.0f)
-									{
-										standardOffset *= -1.0f;
-										additionalOffset = vehicle->VehicleShield->FrontOffset;
-									}
+			surface = EGameSurface::Vehicle;
+		}
 
-									if (vehicle->VehicleShield->HitEffect != nullptr)
-									{
-										hitParticleSystems.Emplace(vehicle->VehicleShield->HitEffect);
-										hitLocations.Emplace(additionalOffset);
-									}
+#pragma region PickupShield
 
-									if (vehicle->VehicleShield->HitPointEffect != nullptr)
-									{
-										FVector pointOffset = FVector(standardOffset, FMath::FRandRange(-150.0f, 150.0f), FMath::FRandRange(-50.0f, 50.0f));
+		else
+		{
+			// We can assume here that we struck the vehicle's shield.
 
-										hitParticleSystems.Emplace(vehicle->VehicleShield->HitPointEffect);
-										hitLocations.Emplace(additionalOffset + pointOffset);
-									}
+			surface = EGameSurface::Shield;
+			hitComponent = vehicle->VehicleMesh;
 
-									hitSound = vehicle->VehicleShield->HitSound;
-								}
+			float standardOffset = -300.0f;
+			FVector additionalOffset = vehicle->VehicleShield->RearOffset;
 
-#pragma endregion PickupShield
+			if (vehicleTransform.InverseTransformPosition(impactPoint).X > 0.0f)
+			{
+				standardOffset *= -1.0f;
+				additionalOffset = vehicle->VehicleShield->FrontOffset;
+			}
 
-								// Calculate a reflection vector between the incoming round and the vehicle it's
-								// hit to determine how to orient any visual hit effects.
+			if (vehicle->VehicleShield->HitEffect != nullptr)
+			{
+				hitParticleSystems.Emplace(vehicle->VehicleShield->HitEffect);
+				hitLocations.Emplace(additionalOffset);
+			}
 
-								FVector strikeNormal = end - location; strikeNormal.Normalize();
-								FVector reflectNormal = FMath::GetReflectionVector(strikeNormal, HitResult.ImpactNormal); reflectNormal.Normalize();
+			if (vehicle->VehicleShield->HitPointEffect != nullptr)
+			{
+				FVector pointOffset = FVector(standardOffset, FMath::FRandRange(-150.0f, 150.0f), FMath::FRandRange(-50.0f, 50.0f));
 
-								impactRotation = reflectNormal.Rotation();
-							}
-							else if (HitResult.GetComponent()->IsA<UMeshComponent>() == true)
-							{
-								// Handle the hitting of a mesh component with a round.
+				hitParticleSystems.Emplace(vehicle->VehicleShield->HitPointEffect);
+				hitLocations.Emplace(additionalOffset + pointOffset);
+			}
 
-								// If this is a mesh component and it's simulating physics then apply an
-								// impulse to it to push it around.
+			hitSound = vehicle->VehicleShield->HitSound;
+		}
 
-								UMeshComponent* mesh = Cast<UMeshComponent>(HitResult.GetComponent());
+#pragma endregion PickupShield
 
-								if (mesh->IsSimulatingPhysics() == true)
-								{
-									mesh->AddImpulseAtLocation(direction * 100.0f * 10000.0f * RoundForce, impactPoint);
-								}
-							}
+		// Calculate a reflection vector between the incoming round and the vehicle it's
+		// hit to determine how to orient any visual hit effects.
 
-							if (surface == EGameSurface::Default)
-							{
-								surface = (EGameSurface)UGameplayStatics::GetSurfaceType(HitResult);
-							}
+		FVector strikeNormal = end - start; strikeNormal.Normalize();
+		FVector reflectNormal = FMath::GetReflectionVector(strikeNormal, hitResult.ImpactNormal); reflectNormal.Normalize();
 
-							FVector color = GameState->TransientGameState.MapSurfaceColor * GameState->TransientGameState.MapLightingColor * 0.75f;
+		impactRotation = reflectNormal.Rotation();
+	}
+	else if (hitComponent != nullptr &&
+		hitComponent->IsA<UMeshComponent>() == true)
+	{
+		// Handle the hitting of a mesh component with a round.
 
-							if (LaunchVehicle != nullptr)
-							{
-								color = LaunchVehicle->GetDustColor(true);
-							}
+		// If this is a mesh component and it's simulating physics then apply an
+		// impulse to it to push it around.
 
-							// Process the main audio / visual effects of the round striking a surface.
+		UMeshComponent* mesh = Cast<UMeshComponent>(hitComponent);
 
-							BulletHitAnimation(hitComponent, hitParticleSystems, hitLocations, hitSound, impactPoint, impactRotation, surface, color, IsCharged());
-						}
+		if (mesh->IsSimulatingPhysics() == true)
+		{
+			FVector direction = end - start; direction.Normalize();
 
-						NumRoundsFired++;
-					}
-				}
-			}
+			mesh->AddImpulseAtLocation(direction * 100.0f * 10000.0f * RoundForce, impactPoint);
 		}
 	}
+
+	if (surface == EGameSurface::Default)
+	{
+		surface = (EGameSurface)UGameplayStatics::GetSurfaceType(hitResult);
+	}
+
+	FVector color = GameState->TransientGameState.MapSurfaceColor * GameState->TransientGameState.MapLightingColor * 0.75f;
+
+	if (LaunchVehicle != nullptr)
+	{
+		color = LaunchVehicle->GetDustColor(true);
+	}
+
+	// Process the main audio / visual effects of the round striking a surface.
+
+	BulletHitAnimation(hitComponent, hitParticleSystems, hitLocations, hitSound, impactPoint, impactRotation, surface, color, IsCharged());
 }
 
 /**
@@ -411,9 +430,6 @@ void AGatlingGun::ActivatePickup(ABaseVehicle* launchVehicle, int32 pickupSlot,
 
 	GunHost = Cast<IGunHostInterface>(LaunchPlatform.Get());
 
-	QueryParams = FCollisionQueryParams(TEXT("Bullet"), true, LaunchPlatform.Get());
-	QueryParams.bReturnPhysicalMaterial = true;
-
 	if (BarrelSpinAudio != nullptr)
 	{
 		BarrelSpinAudio->SetSound(GunHost->UseHumanPlayerAudio() ? BarrelSpinSound : BarrelSpinSoundNonPlayer);
@@ -434,6 +450,46 @@ void AGatlingGun::ActivatePickup(ABaseVehicle* launchVehicle, int32 pickupSlot,
 	Target = SelectTarget(launchVehicle, nullptr, AutoAiming, weight, false);
 }
 
+/**
+* Reset the gun when it's returned to the actor pool.
+***********************************************************************************/
+
+void AGatlingGun::OnReleasedToPool()
+{
+	if (PlayGameMode != nullptr)
+	{
+		PlayGameMode->GetGunRoundManager().FlushRounds(this);
+	}
+
+	ResetPickup();
+
+	if (BarrelSpinAudio != nullptr)
+	{
+		BarrelSpinAudio->Stop();
+
+		GRIP_DETACH(BarrelSpinAudio);
+	}
+
+	// Duration is set to -1 when attached to a launch platform, so restore it.
+
+	Duration = GetClass()->GetDefaultObject<AGatlingGun>()->Duration;
+
+	Target.Reset();
+	LaunchPlatform.Reset();
+	GunHost = nullptr;
+	Timer = 0.0f;
+	RoundTimer = 0.0f;
+	HitRatio = 1.0f;
+	RoundLocation = 0;
+	NumRoundsFired = 0;
+	NumRoundsHitVehicle = 0;
+	LastImpact = FVector::ZeroVector;
+	NumPoints = 0;
+	SpinSide = 0.0f;
+	HaltRounds = false;
+	HitVehicles.Reset();
+}
+
 /**
 * Attach to a launch platform, like a defense turret.
 ***********************************************************************************/
@@ -446,9 +502,6 @@ void AGatlingGun::AttachLaunchPlatform(AActor* launchPlatform)
 	LaunchPlatform = launchPlatform;
 	GunHost = Cast<IGunHostInterface>(launchPlatform);
 
-	QueryParams = FCollisionQueryParams(TEXT("Bullet"), true, LaunchPlatform.Get());
-	QueryParams.bReturnPhysicalMaterial = true;
-
 	GRIP_ATTACH(BarrelSpinAudio, launchPlatform->GetRootComponent(), NAME_None);
 }
 
@@ -501,62 +554,58 @@ AActor* AGatlingGun::SelectTarget(AActor* launchPlatform, FPlayerPickupSlot* lau
 	APlayGameMode* gameMode = APlayGameMode::Get(launchPlatform);
 	ABaseVehicle* launchVehicle = Cast<ABaseVehicle>(launchPlatform);
 
-	// Search for the best target vehicle for the launch platform's current condition.
+	// Search for the best target vehicle for the launch platform's current condition,
+	// only considering the vehicles that could possibly be within range and inside the cone.
+
+	FVehicleBroadphase::FVehicleList vehicles;
 
-	GRIP_GAME_MODE_LIST_FOR(GetVehicles(), vehicles, launchPlatform);
+	gameMode->GetVehicleBroadphase().QueryCone(fromPosition, fromDirection, 250.0f * 100.0f, 1.0f - spread, vehicles);
+
+	bool launchedByHuman = (launchVehicle != nullptr && launchVehicle->IsAIVehicle() == false);
+
+	// Gather the positions of the vehicles that could be targeted so they can all be
+	// weighed together.
+
+	FTargetWeights weights;
+	FVehicleBroadphase::FVehicleList candidates;
 
 	for (ABaseVehicle* vehicle : vehicles)
 	{
-		if ((vehicle != launchVehicle) &&
-			(vehicle->IsVehicleDestroyed() == false) &&
-			(speculative == false || vehicle->IsGoodForSmacking() == true) &&
-			((launchVehicle != nullptr && launchVehicle->IsAIVehicle() == false) || vehicle->CanBeAttacked() == true) &&
-			(launchPickup == nullptr || launchPickup->BotWillTargetHuman == false || vehicle->IsAIVehicle() == false))
+		if (vehicle == launchVehicle ||
+			vehicle->IsVehicleDestroyed() == true)
 		{
-			FVector targetPosition = vehicle->GetTargetBullsEye();
-			float thisWeight = FMathEx::TargetWeight(fromPosition, fromDirection, targetPosition, 5.0f * 100.0f, 250.0f * 100.0f, 1.0f - spread, true);
+			continue;
+		}
 
-			thisWeight = gameMode->ScaleOffensivePickupWeight(launchVehicle != nullptr && launchVehicle->HasAIDriver(), thisWeight, launchPickup, gameMode->VehicleShouldFightVehicle(launchVehicle, vehicle));
+		FVehicleCombatFlags flags = gameMode->GetVehicleCombatFlags(vehicle);
 
-			if (thisWeight >= 0.0f &&
-				minCorrection > thisWeight)
-			{
-				minCorrection = thisWeight;
-				result = vehicle;
-			}
+		if ((speculative == false || flags.IsGoodForSmacking == true) &&
+			(launchedByHuman == true || flags.CanBeAttacked == true) &&
+			(launchPickup == nullptr || launchPickup->BotWillTargetHuman == false || flags.IsAIVehicle == false))
+		{
+			candidates.Emplace(vehicle);
+			weights.Add(vehicle->GetTargetBullsEye());
 		}
 	}
 
-	weight = 1.0f - minCorrection;
-
-	return result;
-}
+	weights.Compute(fromPosition, fromDirection, 5.0f * 100.0f, 250.0f * 100.0f, 1.0f - spread, true);
 
-/**
-* Sweep along projectile direction to see if it hits something along the way.
-***********************************************************************************/
-
-bool AGatlingGun::GetCollision(UWorld* world, const FVector& start, const FVector& end, float& time, AActor* ignoreTarget)
-{
-	if ((end - start).Size() > SMALL_NUMBER)
+	for (int32 i = 0; i < candidates.Num(); i++)
 	{
-		QueryParams.ClearIgnoredActors();
-		QueryParams.AddIgnoredActor(LaunchPlatform.Get());
+		ABaseVehicle* vehicle = candidates[i];
+		float thisWeight = gameMode->ScaleOffensivePickupWeight(launchVehicle != nullptr && launchVehicle->HasAIDriver(), weights.GetWeight(i), launchPickup, gameMode->VehicleShouldFightVehicle(launchVehicle, vehicle));
 
-		if (ignoreTarget != nullptr)
+		if (thisWeight >= 0.0f &&
+			minCorrection > thisWeight)
 		{
-			QueryParams.AddIgnoredActor(ignoreTarget);
-		}
-
-		if (world->LineTraceSingleByChannel(HitResult, start, end, ABaseGameMode::ECC_LineOfSightTestIncVehicles, QueryParams) == true)
-		{
-			time = HitResult.GetComponent() ? HitResult.Time : 1.f;
-
-			return HitResult.GetActor() != nullptr;
+			minCorrection = thisWeight;
+			result = vehicle;
 		}
 	}
 
-	return false;
+	weight = 1.0f - minCorrection;
+
+	return result;
 }
 
 #pragma region BotCombatTraining
@@ -579,7 +628,6 @@ float AGatlingGun::EfficacyWeighting(ABaseVehicle* launchVehicle, FPlayerPickupS
 
 		if (targetSelected != nullptr)
 		{
-			FHitResult hitResult;
 			FCollisionQueryParams queryParams(TEXT("GunVisibilityTest"), true);
 
 			queryParams.AddIgnoredActor(launchVehicle);
@@ -587,10 +635,10 @@ float AGatlingGun::EfficacyWeighting(ABaseVehicle* launchVehicle, FPlayerPickupS
 
 			FVector position = launchVehicle->GetCenterLocation();
 			ABaseVehicle* vehicle = Cast<ABaseVehicle>(targetSelected);
-			FVector offset = (vehicle != nullptr) ? vehicle->GetSurfaceDirection() * -100.0f : FVector(0.0f, 0.0f, -100.0f);
+			FVector offset = (vehicle != nullptr) ? vehicle->GetFrameSnapshot().SurfaceDirection * -100.0f : FVector(0.0f, 0.0f, -100.0f);
 			FVector targetPosition = ((vehicle != nullptr) ? vehicle->GetCenterLocation() : targetSelected->GetActorLocation()) + offset;
 
-			if (launchVehicle->GetWorld()->LineTraceSingleByChannel(hitResult, position + launchVehicle->GetSurfaceDirection() * -100.0f, targetPosition, ABaseGameMode::ECC_LineOfSightTest, queryParams) == true)
+			if (FVisibilityQueryService::LineOfSight(launchVehicle, launchVehicle, targetSelected, position + launchVehicle->GetSurfaceDirection() * -100.0f, targetPosition, ABaseGameMode::ECC_LineOfSightTest, queryParams, 0.25f, EVisibilityQueryFallback::AssumeHidden) == false)
 			{
 				weight = 0.0f;
 			}
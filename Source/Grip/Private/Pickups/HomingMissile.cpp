@@ -14,6 +14,7 @@
 #include "pickups/homingmissile.h"
 #include "vehicle/flippablevehicle.h"
 #include "gamemodes/basegamemode.h"
+#include "system/targetweights.h"
 
 /**
 * Construct a UMissileHostInterface.
@@ -91,6 +92,8 @@ void AHomingMissile::PostInitializeComponents()
 	MissileMesh->SetCollisionEnabled(ECollisionEnabled::Type::NoCollision);
 
 	LastLocation = LastSubLocation = GetActorLocation();
+
+	Random.Seed(FMath::Rand());
 }
 
 /**
@@ -176,7 +179,7 @@ void AHomingMissile::Tick(float deltaSeconds)
 
 			if (GRIP_OBJECT_VALID(LaunchVehicle) == true)
 			{
-				FVector surfaceNormal = LaunchVehicle->GuessSurfaceNormal();
+				FVector surfaceNormal = LaunchVehicle->GetFrameSnapshot().GuessedSurfaceNormal;
 
 				if (surfaceNormal.IsZero() == false)
 				{
@@ -273,16 +276,37 @@ void AHomingMissile::Tick(float deltaSeconds)
 
 					if (determineDirection == true)
 					{
+						// The target's pursuit spline is now the better one to use for answering terrain
+						// probes from, as we're closer to it than to the launcher.
+
+						const FRouteFollower& routeFollower = targetVehicle->GetAI().RouteFollower;
+
+						if (GRIP_POINTER_VALID(routeFollower.ThisSpline) == true &&
+							MissileMovement->GetTerrainSpline() != routeFollower.ThisSpline.Get())
+						{
+							// Find where the missile itself is along that spline, searching around the
+							// target's distance over a window that covers the gap between the two.
+
+							int32 numIterations = 4;
+							UPursuitSplineComponent* spline = routeFollower.ThisSpline.Get();
+							float range = (FMath::Sqrt(d1) * GRIP_SPLINE_MOVEMENT_MULTIPLIER) + FMathEx::MetersToCentimeters(10.0f);
+							float t0 = routeFollower.ThisDistance - range;
+							float t1 = routeFollower.ThisDistance + range;
+							float distance = spline->GetNearestDistance(missileLocation, t0, t1, numIterations, spline->GetNumSamplesForRange(t1 - t0, numIterations, 100.0f));
+
+							MissileMovement->SetTerrainSpline(spline, distance);
+						}
+
 						// Determine the direction of the surface that the target vehicle is traveling on.
 
 						FVector surfaceDirection = FVector::ZeroVector;
-						bool directionValid = targetVehicle->IsPracticallyGrounded();
+						bool directionValid = targetVehicle->GetFrameSnapshot().PracticallyGrounded;
 
 						if (directionValid == true)
 						{
 							// This is going to be the case the vast majority of the time.
 
-							surfaceDirection = targetVehicle->GetSurfaceDirection();
+							surfaceDirection = targetVehicle->GetFrameSnapshot().SurfaceDirection;
 						}
 						else
 						{
@@ -292,7 +316,7 @@ void AHomingMissile::Tick(float deltaSeconds)
 
 							FHitResult hitResult;
 
-							if (GetWorld()->LineTraceSingleByChannel(hitResult, missileLocation, targetLocation, ABaseGameMode::ECC_LineOfSightTest, MissileToTargetQueryParams) == true)
+							if (MissileMovement->ProbeTerrain(hitResult, missileLocation, targetLocation, ABaseGameMode::ECC_LineOfSightTest, MissileToTargetQueryParams) == true)
 							{
 								directionValid = true;
 								surfaceDirection = hitResult.ImpactNormal * -1.0f;
@@ -381,7 +405,7 @@ void AHomingMissile::Ignite()
 
 	if (GRIP_OBJECT_VALID(LaunchVehicle) == true)
 	{
-		FVector surfaceNormal = LaunchVehicle->GuessSurfaceNormal();
+		FVector surfaceNormal = LaunchVehicle->GetFrameSnapshot().GuessedSurfaceNormal;
 
 		// Do some magic to stop the missile hitting the damn floor so often.
 
@@ -392,7 +416,7 @@ void AHomingMissile::Ignite()
 
 			// Get a predicted velocity which more closely follows the vehicle's actual trajectory on launching.
 
-			FVector launcherVelocity = LaunchVehicle->GetPredictedVelocity();
+			FVector launcherVelocity = LaunchVehicle->GetFrameSnapshot().PredictedVelocity;
 			float launcherSpeed = launcherVelocity.Size();
 
 			// First, ensure that the launcher velocity isn't taking us towards the ground by more than
@@ -440,7 +464,7 @@ void AHomingMissile::Ignite()
 	if (DieAt == 0.0f &&
 		RocketDuration > KINDA_SMALL_NUMBER)
 	{
-		DieAt = FMath::FRandRange(RocketDuration, RocketDuration * 1.25f);
+		DieAt = Random.GetRange(RocketDuration, RocketDuration * 1.25f);
 	}
 }
 
@@ -576,12 +600,12 @@ void AHomingMissile::Explode(AActor* hitActor, const FHitResult* hitResult)
 
 void AHomingMissile::SetupFalseTarget()
 {
-	RandomDrift.X = FMath::FRandRange(-20.0f, 20.0f);
-	RandomDrift.Y = FMath::FRandRange(0.0f, 10.0f);
+	RandomDrift.X = Random.GetRange(-20.0f, 20.0f);
+	RandomDrift.Y = Random.GetRange(0.0f, 10.0f);
 
 	MissileMovement->FalseTarget(MissileHost->GetMissileFalseTarget(), RandomDrift);
 
-	DieAt = Timer + 2.5f + (FMath::Rand() & 255) * (2.0f / 255.0f);
+	DieAt = Timer + 2.5f + Random * 2.0f;
 }
 
 /**
@@ -590,7 +614,6 @@ void AHomingMissile::SetupFalseTarget()
 
 bool AHomingMissile::SelectTarget(AActor* launchPlatform, FPlayerPickupSlot* launchPickup, AActor*& existingTarget, TArray<TWeakObjectPtr<AActor>>& targetList, float& weight, int32 maxTargets, bool speculative)
 {
-	FHitResult hitResult;
 	float maxWeight = 0.0f;
 	float maxCone = FMathEx::ConeDegreesToDotProduct(80.0f);
 	APlayGameMode* gameMode = APlayGameMode::Get(launchPlatform);
@@ -599,6 +622,11 @@ bool AHomingMissile::SelectTarget(AActor* launchPlatform, FPlayerPickupSlot* lau
 	FVector fromDirection = launchPlatform->GetActorQuat().GetAxisX();
 	FVector fromLocation = (launchVehicle != nullptr) ? launchVehicle->GetTargetBullsEye() + (launchVehicle->GetLaunchDirection() * 300.0f) : launchPlatform->GetActorLocation();
 
+	// Speculative selections are made every frame by the bots and can happily wait a
+	// frame for line-of-sight, but actual launches need to know right away.
+
+	EVisibilityQueryFallback visibilityFallback = (speculative == true) ? EVisibilityQueryFallback::AssumeHidden : EVisibilityQueryFallback::Synchronous;
+
 	targetList.Empty();
 
 	if ((existingTarget != nullptr) &&
@@ -617,7 +645,7 @@ bool AHomingMissile::SelectTarget(AActor* launchPlatform, FPlayerPickupSlot* lau
 
 			queryParams.AddIgnoredActor(existingTarget);
 
-			if (launchVehicle->GetWorld()->LineTraceSingleByChannel(hitResult, fromLocation, targetLocation, ABaseGameMode::ECC_LineOfSightTest, queryParams) == false)
+			if (FVisibilityQueryService::LineOfSight(launchPlatform, launchPlatform, existingTarget, fromLocation, targetLocation, ABaseGameMode::ECC_LineOfSightTest, queryParams, 0.1f, visibilityFallback) == true)
 			{
 				targetList.Add(existingTarget);
 
@@ -631,6 +659,41 @@ bool AHomingMissile::SelectTarget(AActor* launchPlatform, FPlayerPickupSlot* lau
 		}
 	}
 
+	// Only consider the vehicles that could possibly be within range and inside the cone.
+
+	FVehicleBroadphase::FVehicleList vehicles;
+
+	gameMode->GetVehicleBroadphase().QueryCone(fromLocation, fromDirection, 750.0f * 100.0f, maxCone, vehicles);
+
+	bool launchedByHuman = (launchVehicle != nullptr && launchVehicle->IsAIVehicle() == false);
+
+	// Gather the locations of the vehicles that could be targeted and weigh them all
+	// together, just the once, as the weights don't change as targets are selected.
+
+	FTargetWeights weights;
+	FVehicleBroadphase::FVehicleList candidates;
+
+	for (ABaseVehicle* vehicle : vehicles)
+	{
+		if (vehicle == launchVehicle ||
+			vehicle->IsVehicleDestroyed() == true)
+		{
+			continue;
+		}
+
+		FVehicleCombatFlags flags = gameMode->GetVehicleCombatFlags(vehicle);
+
+		if ((speculative == false || flags.IsGoodForSmacking == true) &&
+			(launchedByHuman == true || flags.CanBeAttacked == true) &&
+			(launchPickup == nullptr || launchPickup->BotWillTargetHuman == false || flags.IsAIVehicle == false))
+		{
+			candidates.Emplace(vehicle);
+			weights.Add(GetTargetLocationFor(vehicle, FVector::ZeroVector));
+		}
+	}
+
+	weights.Compute(fromLocation, fromDirection, 35.0f * 100.0f, 750.0f * 100.0f, maxCone, true);
+
 	while (true)
 	{
 		float minCorrection = 1.0f;
@@ -639,37 +702,30 @@ bool AHomingMissile::SelectTarget(AActor* launchPlatform, FPlayerPickupSlot* lau
 
 		// Search for the best target vehicle for the launch platform's current condition.
 
-		GRIP_GAME_MODE_LIST_FOR(GetVehicles(), vehicles, launchVehicle);
-
-		for (ABaseVehicle* vehicle : vehicles)
+		for (int32 i = 0; i < candidates.Num(); i++)
 		{
-			if (targetList.Contains(Cast<AActor>(vehicle)) == false)
+			ABaseVehicle* vehicle = candidates[i];
+
+			if (targetList.Contains(Cast<AActor>(vehicle)) == true)
 			{
-				if ((vehicle != launchVehicle) &&
-					(vehicle->IsVehicleDestroyed() == false) &&
-					(speculative == false || vehicle->IsGoodForSmacking() == true) &&
-					((launchVehicle != nullptr && launchVehicle->IsAIVehicle() == false) || vehicle->CanBeAttacked() == true) &&
-					(launchPickup == nullptr || launchPickup->BotWillTargetHuman == false || vehicle->IsAIVehicle() == false))
-				{
-					FVector targetLocation = GetTargetLocationFor(vehicle, FVector::ZeroVector);
+				continue;
+			}
 
-					float thisWeight = FMathEx::TargetWeight(fromLocation, fromDirection, targetLocation, 35.0f * 100.0f, 750.0f * 100.0f, maxCone, true);
+			FVector targetLocation = weights.GetPosition(i);
 
-					thisWeight = gameMode->ScaleOffensivePickupWeight(launchVehicle != nullptr && launchVehicle->HasAIDriver(), thisWeight, launchPickup, gameMode->VehicleShouldFightVehicle(launchVehicle, vehicle));
+			float thisWeight = gameMode->ScaleOffensivePickupWeight(launchVehicle != nullptr && launchVehicle->HasAIDriver(), weights.GetWeight(i), launchPickup, gameMode->VehicleShouldFightVehicle(launchVehicle, vehicle));
 
-					if (thisWeight >= 0.0f &&
-						minCorrection > thisWeight)
-					{
-						FCollisionQueryParams queryParams("TargetSelection", false, launchVehicle);
+			if (thisWeight >= 0.0f &&
+				minCorrection > thisWeight)
+			{
+				FCollisionQueryParams queryParams("TargetSelection", false, launchVehicle);
 
-						queryParams.AddIgnoredActor(vehicle);
+				queryParams.AddIgnoredActor(vehicle);
 
-						if (launchVehicle->GetWorld()->LineTraceSingleByChannel(hitResult, fromLocation, targetLocation, ABaseGameMode::ECC_LineOfSightTest, queryParams) == false)
-						{
-							minCorrection = thisWeight;
-							existingTarget = vehicle;
-						}
-					}
+				if (FVisibilityQueryService::LineOfSight(launchPlatform, launchPlatform, vehicle, fromLocation, targetLocation, ABaseGameMode::ECC_LineOfSightTest, queryParams, 0.1f, visibilityFallback) == true)
+				{
+					minCorrection = thisWeight;
+					existingTarget = vehicle;
 				}
 			}
 		}
@@ -1081,7 +1137,7 @@ void AHomingMissile::ActivatePickup(ABaseVehicle* launchVehicle, int32 pickupSlo
 		float ejectScale = 1.0f - (FMathEx::GetRatio(speed, 0.0f, 400.0f) * 0.75f);
 
 		yaw = 0.0f;
-		pitch = FMath::RandRange(0.3f, 0.3f + (0.3f * ejectScale));
+		pitch = Random.GetRange(0.3f, 0.3f + (0.3f * ejectScale));
 
 		if (constrainUp == true)
 		{
@@ -1116,6 +1172,13 @@ void AHomingMissile::ActivatePickup(ABaseVehicle* launchVehicle, int32 pickupSlo
 		MissileMovement->TerrainDirection = LaunchVehicle->GetSurfaceDirection();
 	}
 
+	// Start off answering terrain probes from the launch vehicle's pursuit spline.
+
+	if (GRIP_POINTER_VALID(routeFollower.ThisSpline) == true)
+	{
+		MissileMovement->SetTerrainSpline(routeFollower.ThisSpline.Get(), routeFollower.ThisDistance);
+	}
+
 	MissileMovement->SetLoseLockOnRear(LoseLockOnRear);
 
 	GRIP_ADD_TO_GAME_MODE_LIST(Missiles);
@@ -1150,8 +1213,8 @@ void AHomingMissile::Launch(const FVector& location, const FVector& velocity)
 
 	RootComponent->SetWorldLocation(location);
 
-	RandomDrift.X = FMath::FRandRange(-20.0f, 20.0f);
-	RandomDrift.Y = FMath::FRandRange(0.0f, 10.0f);
+	RandomDrift.X = Random.GetRange(-20.0f, 20.0f);
+	RandomDrift.Y = Random.GetRange(0.0f, 10.0f);
 	IgnitionTime = 0.0f;
 
 	MissileMesh->MoveIgnoreActors.Emplace(LaunchPlatform.Get());
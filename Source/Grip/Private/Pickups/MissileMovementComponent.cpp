@@ -90,6 +90,11 @@ void UMissileMovementComponent::TickComponent(float deltaSeconds, enum ELevelTic
 		queryParams.AddIgnoredActor(missile->GetLaunchPlatform());
 	}
 
+	// Keep track of where we are along the terrain spline, for answering terrain
+	// probes from its clearance data.
+
+	UpdateTerrainSpline(actorOwner->GetActorLocation());
+
 	// Handle the main update of the movement.
 
 	while (remainingTime >= MinimumTickTime && actorOwner->IsPendingKill() == false && GRIP_OBJECT_VALID(UpdatedComponent) == true)
@@ -249,7 +254,7 @@ FVector UMissileMovementComponent::ComputeAcceleration(const FVector& velocity,
 					// make sure we hit the damn thing.
 
 					float aimHigh = FMathEx::MetersToCentimeters(5.0f);
-					FVector targetVelocity = vehicle->GetPredictedVelocity();
+					FVector targetVelocity = vehicle->GetFrameSnapshot().PredictedVelocity;
 					FVector launchDirection = vehicle->GetLaunchDirection();
 
 					if (TerrainAvoidanceHeight > KINDA_SMALL_NUMBER)
@@ -88,10 +88,13 @@ void APickupEffect::SetLocationAndScale(USceneComponent* component, const FVecto
 
 void APickupEffect::OnPickupPadCollected()
 {
+	// The idle effect is the root component, so just switch it off rather than
+	// destroying it, so the effect can be reused through the actor pool.
+
 	if (GRIP_OBJECT_VALID(IdleEffect) == true)
 	{
-		IdleEffect->DestroyComponent();
-		IdleEffect = nullptr;
+		IdleEffect->DeactivateImmediate();
+		IdleEffect->SetHiddenInGame(true);
 	}
 
 	if (GRIP_OBJECT_VALID(PickedUpEffect) == true)
@@ -101,6 +104,29 @@ void APickupEffect::OnPickupPadCollected()
 	}
 }
 
+/**
+* Reset the effect when it's returned to the actor pool.
+***********************************************************************************/
+
+void APickupEffect::OnReleasedToPool()
+{
+	if (GRIP_OBJECT_VALID(PickedUpEffect) == true)
+	{
+		PickedUpEffect->DeactivateImmediate();
+		PickedUpEffect->SetHiddenInGame(true);
+
+		GRIP_DETACH(PickedUpEffect);
+	}
+
+	if (GRIP_OBJECT_VALID(IdleEffect) == true)
+	{
+		IdleEffect->DeactivateImmediate();
+		IdleEffect->SetHiddenInGame(true);
+
+		GRIP_DETACH(IdleEffect);
+	}
+}
+
 /**
 * Do some post initialization just before the game is ready to play.
 ***********************************************************************************/
@@ -269,20 +295,37 @@ bool APickup::Spawn()
 	{
 		// If we already have a pickup effect then kill it off.
 
+		APlayGameMode* gameMode = APlayGameMode::Get(this);
+
 		if (GRIP_OBJECT_VALID(PickupEffect) == true)
 		{
-			PickupEffect->Destroy();
+			if (gameMode != nullptr)
+			{
+				gameMode->GetActorPool().Release(PickupEffect);
+			}
+			else
+			{
+				PickupEffect->Destroy();
+			}
+
 			PickupEffect = nullptr;
 		}
 
-		// Spawn a new pickup effect and set it up.
+		// Spawn a new pickup effect, or reuse one from the actor pool, and set it up.
 
 		FActorSpawnParameters spawnParams;
 
 		spawnParams.Owner = this;
 		spawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
 
-		PickupEffect = GetWorld()->SpawnActor<APickupEffect>(Effect, PadMesh->GetComponentLocation(), PadMesh->GetComponentRotation(), spawnParams);
+		if (gameMode != nullptr)
+		{
+			PickupEffect = gameMode->GetActorPool().Acquire<APickupEffect>(GetWorld(), Effect, PadMesh->GetComponentLocation(), PadMesh->GetComponentRotation(), spawnParams);
+		}
+		else
+		{
+			PickupEffect = GetWorld()->SpawnActor<APickupEffect>(Effect, PadMesh->GetComponentLocation(), PadMesh->GetComponentRotation(), spawnParams);
+		}
 
 		PickupEffect->SetLocationAndScale(PadMesh, FVector(0.0f, 0.0f, SurfaceOffset), Scale);
 
@@ -51,7 +51,7 @@ void APickupBase::ActivatePickup(ABaseVehicle* launchVehicle, int32 pickupSlot,
 }
 
 /**
-* Destroy the pickup.
+* Destroy the pickup, returning it to the actor pool if it's poolable.
 ***********************************************************************************/
 
 void APickupBase::DestroyPickup()
@@ -62,7 +62,25 @@ void APickupBase::DestroyPickup()
 		PlayGameMode->RemovePickupType(PickupType);
 	}
 
-	Destroy();
+	if (PlayGameMode != nullptr)
+	{
+		PlayGameMode->GetActorPool().Release(this);
+	}
+	else
+	{
+		Destroy();
+	}
+}
+
+/**
+* Reset the pickup to its unused state, for when it's returned to the actor pool.
+***********************************************************************************/
+
+void APickupBase::ResetPickup()
+{
+	LaunchVehicle = nullptr;
+	PickupSlot = 0;
+	Charged = false;
 }
 
 /**
@@ -62,6 +62,25 @@ void ATurbo::ActivatePickup(ABaseVehicle* launchVehicle, int32 pickupSlot, EPick
 	launchVehicle->TurboEngaged();
 }
 
+/**
+* Reset the turbo when it's returned to the actor pool.
+***********************************************************************************/
+
+void ATurbo::OnReleasedToPool()
+{
+	ResetPickup();
+
+	ActiveAudio->Stop();
+	ActiveAudio->SetVolumeMultiplier(0.0f);
+
+	GRIP_DETACH(ActiveAudio);
+
+	Timer = 0.0f;
+	Duration = 5.0f;
+	NormalizeScale = 1.0f;
+	ActivateSoundPlayed = false;
+}
+
 /**
 * Do the regular update tick.
 ***********************************************************************************/
@@ -0,0 +1,234 @@
+/**
+*
+* A frame-budgeted scheduler for AI work.
+*
+* Original author: Rob Baker.
+* Current maintainer: Rob Baker.
+*
+* Copyright Caged Element Inc, code provided for educational purposes only.
+*
+* Expensive but non-critical AI work, like scanning for targets of opportunity or
+* validating the spline being followed, doesn't need to be done every frame. The
+* scheduler decides once per frame which vehicles get to do each type of work on
+* the next frame, in priority order and within a microsecond budget, while
+* guaranteeing that no work is deferred for longer than its maximum staleness.
+*
+***********************************************************************************/
+
+#include "system/aiworkscheduler.h"
+#include "system/mathhelpers.h"
+
+/**
+* The per-frame budget for AI work.
+***********************************************************************************/
+
+static TAutoConsoleVariable<float> CVarAIWorkBudget(
+	TEXT("grip.AIWorkBudget"),
+	750.0f,
+	TEXT("The per-frame budget for scheduled AI work, in microseconds.\n"),
+	ECVF_Default);
+
+/**
+* The desired period between each type of AI work, in seconds.
+***********************************************************************************/
+
+const float FAIWorkScheduler::WorkPeriods[(int32)EAIWorkType::Num] =
+{
+	0.25f,	// RouteFollowing
+	0.1f,	// Opportunities
+	0.1f,	// RollControlTrace
+	0.25f,	// StuckDetection
+	0.25f,	// PickupEfficacy
+	0.1f	// PickupEfficacyActive
+};
+
+/**
+* The maximum period between each type of AI work, in seconds.
+***********************************************************************************/
+
+const float FAIWorkScheduler::MaxWorkStaleness[(int32)EAIWorkType::Num] =
+{
+	0.75f,	// RouteFollowing
+	0.5f,	// Opportunities
+	0.3f,	// RollControlTrace
+	1.0f,	// StuckDetection
+	1.0f,	// PickupEfficacy
+	0.3f	// PickupEfficacyActive
+};
+
+/**
+* Set the number of vehicles that AI work is scheduled for, indexed by vehicle
+* index.
+***********************************************************************************/
+
+void FAIWorkScheduler::SetNumVehicles(int32 numVehicles)
+{
+	if (VehicleSlots.Num() != numVehicles)
+	{
+		VehicleSlots.Reset();
+		VehicleSlots.AddDefaulted(numVehicles);
+
+		// Stagger the work across the vehicles to begin with, so that it doesn't all
+		// become due on the same frame.
+
+		for (int32 i = 0; i < numVehicles; i++)
+		{
+			for (int32 j = 0; j < (int32)EAIWorkType::Num; j++)
+			{
+				VehicleSlots[i].Work[j].Staleness = (WorkPeriods[j] / numVehicles) * i;
+				VehicleSlots[i].Work[j].RunNow = false;
+			}
+		}
+	}
+}
+
+/**
+* Set the state used to prioritize the work for a vehicle.
+***********************************************************************************/
+
+void FAIWorkScheduler::SetVehicleState(int32 vehicleIndex, float cameraDistance, int32 racePosition)
+{
+	if (VehicleSlots.IsValidIndex(vehicleIndex) == true)
+	{
+		VehicleSlots[vehicleIndex].CameraDistance = cameraDistance;
+		VehicleSlots[vehicleIndex].RacePosition = racePosition;
+	}
+}
+
+/**
+* Get the priority of a work item that is due.
+***********************************************************************************/
+
+float FAIWorkScheduler::GetPriority(const FAIVehicleSlots& vehicle, EAIWorkType type, float staleness) const
+{
+	// Work becomes more urgent the longer it's been since it was last done.
+
+	float priority = staleness / WorkPeriods[(int32)type];
+
+	// Vehicles close to a camera are the ones the player is most likely to notice
+	// behaving badly, so they get up to three times the priority.
+
+	priority *= 1.0f + FMathEx::GetRatio(250.0f * 100.0f - vehicle.CameraDistance, 0.0f, 250.0f * 100.0f) * 2.0f;
+
+	// Vehicles towards the front of the race have a greater bearing on its outcome.
+
+	if (VehicleSlots.Num() > 1 &&
+		vehicle.RacePosition >= 0)
+	{
+		priority *= 1.0f + (1.0f - ((float)vehicle.RacePosition / (float)(VehicleSlots.Num() - 1))) * 0.5f;
+	}
+
+	return priority;
+}
+
+/**
+* Tick the scheduler at the end of a frame, to schedule the work for the next
+* frame.
+***********************************************************************************/
+
+void FAIWorkScheduler::Tick(float deltaSeconds)
+{
+	// Measure the work done on this frame and update the cost estimates from it.
+
+	float spentMicroseconds = 0.0f;
+
+	for (int32 i = 0; i < (int32)EAIWorkType::Num; i++)
+	{
+		int64 cycles = FPlatformAtomics::InterlockedExchange(&CyclesThisFrame[i], 0);
+		int32 count = FPlatformAtomics::InterlockedExchange(&CountThisFrame[i], 0);
+
+		if (count > 0)
+		{
+			float microseconds = (float)(FPlatformTime::ToSeconds64(cycles) * 1000000.0);
+
+			spentMicroseconds += microseconds;
+
+			EstimatedMicroseconds[i] = FMath::Lerp(EstimatedMicroseconds[i], microseconds / count, 0.1f);
+		}
+	}
+
+	Stats.SpentMicroseconds = spentMicroseconds;
+
+	if (spentMicroseconds > Stats.BudgetMicroseconds &&
+		Stats.BudgetMicroseconds > 0.0f)
+	{
+		Stats.Overruns++;
+	}
+
+	// Now age all of the work and determine which of it is due for the next frame.
+
+	float budget = CVarAIWorkBudget.GetValueOnGameThread();
+	float scheduled = 0.0f;
+
+	Stats.BudgetMicroseconds = budget;
+	Stats.Granted = 0;
+	Stats.Deferred = 0;
+	Stats.Forced = 0;
+	Stats.MaxStaleness = 0.0f;
+
+	Candidates.Reset();
+
+	for (FAIVehicleSlots& vehicle : VehicleSlots)
+	{
+		for (int32 i = 0; i < (int32)EAIWorkType::Num; i++)
+		{
+			FAIWorkSlot& slot = vehicle.Work[i];
+
+			slot.Staleness = (slot.RunNow == true) ? deltaSeconds : slot.Staleness + deltaSeconds;
+			slot.RunNow = false;
+
+			// Assume the next frame will be about as long as this one, and look at how
+			// stale the work will be by the time it gets done.
+
+			float staleness = slot.Staleness + deltaSeconds;
+
+			if (staleness >= MaxWorkStaleness[i])
+			{
+				// Work that has reached its maximum staleness is always done, budget or not.
+
+				slot.RunNow = true;
+				scheduled += EstimatedMicroseconds[i];
+
+				Stats.Forced++;
+				Stats.MaxStaleness = FMath::Max(Stats.MaxStaleness, staleness);
+			}
+			else if (staleness >= WorkPeriods[i])
+			{
+				FAIWorkCandidate& candidate = Candidates.AddDefaulted_GetRef();
+
+				candidate.Slot = &slot;
+				candidate.Type = (EAIWorkType)i;
+				candidate.Priority = GetPriority(vehicle, candidate.Type, staleness);
+			}
+		}
+	}
+
+	// Grant the work that is due in priority order while it fits within the budget,
+	// deferring the rest. Deferred work is coalesced into the single slot for its
+	// type on its vehicle, so it only ever needs doing once when it's granted.
+
+	Candidates.Sort([] (const FAIWorkCandidate& object1, const FAIWorkCandidate& object2)
+		{
+			return object1.Priority > object2.Priority;
+		});
+
+	for (FAIWorkCandidate& candidate : Candidates)
+	{
+		float cost = EstimatedMicroseconds[(int32)candidate.Type];
+
+		if (scheduled + cost <= budget)
+		{
+			candidate.Slot->RunNow = true;
+			scheduled += cost;
+
+			Stats.MaxStaleness = FMath::Max(Stats.MaxStaleness, candidate.Slot->Staleness + deltaSeconds);
+		}
+		else
+		{
+			Stats.Deferred++;
+		}
+	}
+
+	Stats.Granted = Stats.Forced + Candidates.Num() - Stats.Deferred;
+	Stats.ScheduledMicroseconds = scheduled;
+}
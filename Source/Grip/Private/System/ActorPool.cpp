@@ -0,0 +1,290 @@
+/**
+*
+* Actor pool.
+*
+* Original author: Rob Baker.
+* Current maintainer: Rob Baker.
+*
+* Copyright Caged Element Inc, code provided for educational purposes only.
+*
+* Pickups and their effects are used over and over again during a game, and
+* spawning and destroying an actor each time causes hitches on the spawn and
+* churns the garbage collector. Actors that implement the poolable interface are
+* instead returned to a pool, keyed by class, when they're finished with, and
+* reused the next time an actor of that class is asked for. The pool can be
+* pre-warmed at the start of a game so no spawns are needed during it.
+*
+* Pooling is off by default, grip.ActorPooling 1 switching it on, until it's
+* been measured to pay for itself. Run a race with the command line option
+* -GripActorPoolReport to measure the spawns, destroys and garbage collection
+* during it, reported to the log and appended to Saved/Profiling/GripActorPool.csv
+* at the end of the race, and compare the results with pooling on and off.
+*
+***********************************************************************************/
+
+#include "system/actorpool.h"
+#include "system/poolable.h"
+
+DEFINE_STAT(STAT_ActorPoolAcquire);
+DEFINE_STAT(STAT_ActorPoolSpawn);
+DEFINE_STAT(STAT_ActorPoolDestroy);
+DEFINE_STAT(STAT_ActorPoolSpawns);
+DEFINE_STAT(STAT_ActorPoolReuses);
+DEFINE_STAT(STAT_ActorPoolDestroys);
+DEFINE_STAT(STAT_ActorPoolFree);
+
+static TAutoConsoleVariable<int32> CVarActorPooling(
+	TEXT("grip.ActorPooling"),
+	0,
+	TEXT("Recycle pickups and their effects through the actor pool.\n")
+	TEXT("  0: Off, spawn and destroy them each time they're used (default)\n")
+	TEXT("  1: On"),
+	ECVF_Default);
+
+/**
+* Is pooling currently enabled?
+***********************************************************************************/
+
+bool FActorPool::IsEnabled()
+{
+	return (CVarActorPooling.GetValueOnGameThread() != 0);
+}
+
+/**
+* Acquire an actor of a class from the pool, spawning a new one if there are none
+* free.
+***********************************************************************************/
+
+AActor* FActorPool::AcquireActor(UWorld* world, UClass* actorClass, const FVector& location, const FRotator& rotation, const FActorSpawnParameters& spawnParams)
+{
+	SCOPE_CYCLE_COUNTER(STAT_ActorPoolAcquire);
+
+	if (actorClass == nullptr)
+	{
+		return nullptr;
+	}
+
+	TArray<TWeakObjectPtr<AActor>>* freeActors = FreeActors.Find(actorClass);
+
+	while (freeActors != nullptr &&
+		freeActors->Num() > 0)
+	{
+		AActor* actor = freeActors->Pop(false).Get();
+
+		DEC_DWORD_STAT(STAT_ActorPoolFree);
+
+		if (GRIP_OBJECT_VALID(actor) == true &&
+			actor->IsPendingKill() == false)
+		{
+			INC_DWORD_STAT(STAT_ActorPoolReuses);
+
+			actor->SetOwner(spawnParams.Owner);
+			actor->SetActorLocationAndRotation(location, rotation, false, nullptr, ETeleportType::TeleportPhysics);
+			actor->SetActorHiddenInGame(false);
+
+			if (actor->PrimaryActorTick.bCanEverTick == true &&
+				actor->PrimaryActorTick.bStartWithTickEnabled == true)
+			{
+				actor->SetActorTickEnabled(true);
+			}
+
+			Cast<IPoolableInterface>(actor)->OnAcquiredFromPool();
+
+			return actor;
+		}
+	}
+
+	INC_DWORD_STAT(STAT_ActorPoolSpawns);
+
+	SCOPE_CYCLE_COUNTER(STAT_ActorPoolSpawn);
+
+	uint32 startCycles = FPlatformTime::Cycles();
+	AActor* actor = world->SpawnActor<AActor>(actorClass, location, rotation, spawnParams);
+
+	if (Measuring == true)
+	{
+		uint32 cycles = FPlatformTime::Cycles() - startCycles;
+
+		Measurements.NumSpawns++;
+		Measurements.SpawnCycles += cycles;
+		Measurements.WorstSpawnCycles = FMath::Max(Measurements.WorstSpawnCycles, cycles);
+	}
+
+	return actor;
+}
+
+/**
+* Release an actor back to the pool, or destroy it if it isn't poolable.
+***********************************************************************************/
+
+void FActorPool::Release(AActor* actor)
+{
+	if (GRIP_OBJECT_VALID(actor) == false)
+	{
+		return;
+	}
+
+	if (IsEnabled() == false ||
+		Cast<IPoolableInterface>(actor) == nullptr)
+	{
+		INC_DWORD_STAT(STAT_ActorPoolDestroys);
+
+		SCOPE_CYCLE_COUNTER(STAT_ActorPoolDestroy);
+
+		uint32 startCycles = FPlatformTime::Cycles();
+
+		actor->Destroy();
+
+		if (Measuring == true)
+		{
+			Measurements.NumDestroys++;
+			Measurements.DestroyCycles += FPlatformTime::Cycles() - startCycles;
+		}
+
+		return;
+	}
+
+	Deactivate(actor);
+}
+
+/**
+* Spawn enough actors of a class into the pool so that count of them are free.
+***********************************************************************************/
+
+void FActorPool::Prewarm(UWorld* world, UClass* actorClass, int32 count)
+{
+	if (actorClass == nullptr ||
+		IsEnabled() == false ||
+		actorClass->ImplementsInterface(UPoolableInterface::StaticClass()) == false)
+	{
+		return;
+	}
+
+	FActorSpawnParameters spawnParams;
+
+	spawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+
+	TArray<TWeakObjectPtr<AActor>>& freeActors = FreeActors.FindOrAdd(actorClass);
+
+	for (int32 i = freeActors.Num(); i < count; i++)
+	{
+		AActor* actor = world->SpawnActor<AActor>(actorClass, FVector::ZeroVector, FRotator::ZeroRotator, spawnParams);
+
+		if (actor != nullptr)
+		{
+			INC_DWORD_STAT(STAT_ActorPoolSpawns);
+
+			Deactivate(actor);
+		}
+	}
+}
+
+/**
+* Put an actor into the pool, resetting it and taking it out of play.
+***********************************************************************************/
+
+void FActorPool::Deactivate(AActor* actor)
+{
+	Cast<IPoolableInterface>(actor)->OnReleasedToPool();
+
+	actor->SetActorHiddenInGame(true);
+	actor->SetActorTickEnabled(false);
+	actor->SetOwner(nullptr);
+
+	FreeActors.FindOrAdd(actor->GetClass()).Emplace(actor);
+
+	INC_DWORD_STAT(STAT_ActorPoolFree);
+}
+
+/**
+* Start measuring the cost of spawns, destroys and garbage collection, if requested
+* on the command line.
+*
+* This is done once the pool has been pre-warmed, so only the cost during the race
+* itself is measured.
+***********************************************************************************/
+
+void FActorPool::StartMeasuring()
+{
+	if (Measuring == true ||
+		FParse::Param(FCommandLine::Get(), TEXT("GripActorPoolReport")) == false)
+	{
+		return;
+	}
+
+	Measuring = true;
+	Measurements = FMeasurements();
+	Measurements.NumObjectsAtStart = GUObjectArray.GetObjectArrayNumMinusAvailable();
+	Measurements.StartTime = FPlatformTime::Seconds();
+
+	PreGarbageCollectHandle = FCoreUObjectDelegates::GetPreGarbageCollectDelegate().AddRaw(this, &FActorPool::OnPreGarbageCollect);
+	PostGarbageCollectHandle = FCoreUObjectDelegates::GetPostGarbageCollect().AddRaw(this, &FActorPool::OnPostGarbageCollect);
+}
+
+/**
+* Stop measuring and report the results, if measuring.
+***********************************************************************************/
+
+void FActorPool::StopMeasuring(UWorld* world)
+{
+	if (Measuring == false)
+	{
+		return;
+	}
+
+	Measuring = false;
+
+	FCoreUObjectDelegates::GetPreGarbageCollectDelegate().Remove(PreGarbageCollectHandle);
+	FCoreUObjectDelegates::GetPostGarbageCollect().Remove(PostGarbageCollectHandle);
+
+	Report(world);
+}
+
+/**
+* Handle the end of a garbage collection when measuring.
+***********************************************************************************/
+
+void FActorPool::OnPostGarbageCollect()
+{
+	if (Measurements.CollectionStartCycles != 0)
+	{
+		uint32 cycles = FPlatformTime::Cycles() - Measurements.CollectionStartCycles;
+
+		Measurements.NumCollections++;
+		Measurements.CollectionCycles += cycles;
+		Measurements.WorstCollectionCycles = FMath::Max(Measurements.WorstCollectionCycles, cycles);
+		Measurements.CollectionStartCycles = 0;
+	}
+}
+
+/**
+* Report the measurements to the log and the profiling CSV file.
+*
+* The object count is the change in the number of UObjects over the race, which
+* shows the allocations that the garbage collector hasn't yet caught up with.
+***********************************************************************************/
+
+void FActorPool::Report(UWorld* world) const
+{
+	int32 pooling = (IsEnabled() == true) ? 1 : 0;
+	double seconds = FPlatformTime::Seconds() - Measurements.StartTime;
+	double spawnMs = FPlatformTime::ToMilliseconds64(Measurements.SpawnCycles);
+	double worstSpawnMs = FPlatformTime::ToMilliseconds(Measurements.WorstSpawnCycles);
+	double destroyMs = FPlatformTime::ToMilliseconds64(Measurements.DestroyCycles);
+	double collectionMs = FPlatformTime::ToMilliseconds64(Measurements.CollectionCycles);
+	double worstCollectionMs = FPlatformTime::ToMilliseconds(Measurements.WorstCollectionCycles);
+	int32 objectsDelta = GUObjectArray.GetObjectArrayNumMinusAvailable() - Measurements.NumObjectsAtStart;
+	FString mapName = (world != nullptr) ? world->GetMapName() : FString();
+
+	UE_LOG(GripLog, Log, TEXT("Actor pool report for %s with pooling %s over %.1fs: %d spawns %.2fms (worst %.2fms), %d destroys %.2fms, %d garbage collections %.2fms (worst %.2fms), %+d objects"), *mapName, (pooling != 0) ? TEXT("on") : TEXT("off"), seconds, Measurements.NumSpawns, spawnMs, worstSpawnMs, Measurements.NumDestroys, destroyMs, Measurements.NumCollections, collectionMs, worstCollectionMs, objectsDelta);
+
+	FString filename = FPaths::ProfilingDir() / TEXT("GripActorPool.csv");
+	FString line = FString::Printf(TEXT("%s,%d,%.1f,%d,%.3f,%.3f,%d,%.3f,%d,%.3f,%.3f,%d%s"), *mapName, pooling, seconds, Measurements.NumSpawns, spawnMs, worstSpawnMs, Measurements.NumDestroys, destroyMs, Measurements.NumCollections, collectionMs, worstCollectionMs, objectsDelta, LINE_TERMINATOR);
+
+	if (IFileManager::Get().FileExists(*filename) == false)
+	{
+		line = FString(TEXT("Map,Pooling,Seconds,Spawns,SpawnMs,WorstSpawnMs,Destroys,DestroyMs,Collections,CollectionMs,WorstCollectionMs,ObjectsDelta")) + LINE_TERMINATOR + line;
+	}
+
+	FFileHelper::SaveStringToFile(line, *filename, FFileHelper::EEncodingOptions::AutoDetect, &IFileManager::Get(), FILEWRITE_Append);
+}
@@ -0,0 +1,118 @@
+/**
+*
+* Grid benchmark.
+*
+* Original author: Rob Baker.
+* Current maintainer: Rob Baker.
+*
+* Copyright Caged Element Inc, code provided for educational purposes only.
+*
+* A benchmark for measuring how the game scales with the size of the grid, well
+* beyond the number of players in a normal event. Run any track map with the
+* command line option -GripBenchmark=N, and the game mode will fill the grid with
+* N bots, replicating the start line backwards if the map doesn't have enough
+* player starts. Once the race has been running for a little while, the game
+* thread and vehicle physics times are sampled for a period and then reported to
+* the log and appended to Saved/Profiling/GripBenchmark.csv. Add -GripBenchmarkExit
+* to quit once reported, and -nullrhi -nosound -unattended to run it headless, so
+* a script can run it for increasing N.
+*
+***********************************************************************************/
+
+#include "system/gridbenchmark.h"
+
+const float FGridBenchmark::WarmupTime = 10.0f;
+const float FGridBenchmark::SampleTime = 30.0f;
+bool FGridBenchmark::Sampling = false;
+FThreadSafeCounter FGridBenchmark::PhysicsCycles;
+
+/**
+* Get the number of vehicles requested for the benchmark, or 0 if not benchmarking.
+***********************************************************************************/
+
+int32 FGridBenchmark::GetNumVehicles()
+{
+	static int32 numVehicles = -1;
+
+	if (numVehicles < 0)
+	{
+		numVehicles = 0;
+
+		FParse::Value(FCommandLine::Get(), TEXT("GripBenchmark="), numVehicles);
+
+		numVehicles = FMath::Clamp(numVehicles, 0, GRIP_MAX_BENCHMARK_PLAYERS);
+	}
+
+	return numVehicles;
+}
+
+/**
+* Tick the benchmark, sampling the thread times once the race is in play.
+***********************************************************************************/
+
+void FGridBenchmark::Tick(int32 numVehicles, bool inPlay)
+{
+	// Always collect the physics cycles so they don't accumulate across frames that
+	// aren't sampled.
+
+	uint32 physicsCycles = (uint32)PhysicsCycles.Set(0);
+
+	if (inPlay == false ||
+		Reported == true)
+	{
+		return;
+	}
+
+	float deltaSeconds = FApp::GetDeltaTime();
+
+	if (Sampling == true)
+	{
+		double gameThreadTime = FPlatformTime::ToMilliseconds(GGameThreadTime);
+
+		NumFrames++;
+		FrameTime += deltaSeconds * 1000.0;
+		GameThreadTime += gameThreadTime;
+		PhysicsTime += FPlatformTime::ToMilliseconds(physicsCycles);
+		MaxGameThreadTime = FMath::Max(MaxGameThreadTime, gameThreadTime);
+	}
+
+	Timer += deltaSeconds;
+
+	if (Timer >= WarmupTime + SampleTime)
+	{
+		Sampling = false;
+		Reported = true;
+
+		Report(numVehicles);
+
+		if (FParse::Param(FCommandLine::Get(), TEXT("GripBenchmarkExit")) == true)
+		{
+			FPlatformMisc::RequestExit(false);
+		}
+	}
+	else
+	{
+		Sampling = (Timer >= WarmupTime);
+	}
+}
+
+/**
+* Report the results of the benchmark.
+***********************************************************************************/
+
+void FGridBenchmark::Report(int32 numVehicles) const
+{
+	double frames = FMath::Max(NumFrames, 1);
+
+	UE_LOG(GripLog, Log, TEXT("Grid benchmark with %d vehicles over %d frames: frame %.2fms, game thread %.2fms (worst %.2fms), vehicle physics %.2fms"), numVehicles, NumFrames, FrameTime / frames, GameThreadTime / frames, MaxGameThreadTime, PhysicsTime / frames);
+
+	FString filename = FPaths::ProfilingDir() / TEXT("GripBenchmark.csv");
+	FString line = FString::Printf(TEXT("%d,%d,%.3f,%.3f,%.3f,%.3f%s"), numVehicles, NumFrames, FrameTime / frames, GameThreadTime / frames, MaxGameThreadTime, PhysicsTime / frames, LINE_TERMINATOR);
+
+	if (IFileManager::Get().FileExists(*filename) == false)
+	{
+		line = FString(TEXT("Vehicles,Frames,FrameMs,GameThreadMs,WorstGameThreadMs,VehiclePhysicsMs")) + LINE_TERMINATOR + line;
+	}
+
+	FFileHelper::SaveStringToFile(line, *filename, FFileHelper::EEncodingOptions::AutoDetect, &IFileManager::Get(), FILEWRITE_Append);
+}
@@ -0,0 +1,202 @@
+/**
+*
+* Gun round manager.
+*
+* Original author: Rob Baker.
+* Current maintainer: Rob Baker.
+*
+* Copyright Caged Element Inc, code provided for educational purposes only.
+*
+* Gatling guns fire up to 30 rounds a second each, and with a grid full of them
+* firing at once each round doing its own synchronous line trace on the game
+* thread adds up quickly. Instead, all of the live rounds from all of the guns
+* are held here, in parallel arrays, and their traces are issued asynchronously
+* so the engine can run them together as a batch. The results are collected on
+* the next frame and handed back to the guns that fired them to apply.
+*
+***********************************************************************************/
+
+#include "system/gunroundmanager.h"
+#include "pickups/gatlinggun.h"
+#include "gamemodes/basegamemode.h"
+
+DEFINE_STAT(STAT_GunRoundsTick);
+DEFINE_STAT(STAT_GunRoundsFired);
+DEFINE_STAT(STAT_GunRoundsHit);
+DEFINE_STAT(STAT_GunRoundsInFlight);
+
+/**
+* Construct the manager.
+***********************************************************************************/
+
+FGunRoundManager::FGunRoundManager()
+	: QueryParams(TEXT("Bullet"), true)
+{
+	QueryParams.bReturnPhysicalMaterial = true;
+}
+
+/**
+* Fire a round from a gun, its hit being applied when the trace for it completes.
+***********************************************************************************/
+
+void FGunRoundManager::FireRound(AGatlingGun* gun, const FVector& start, const FVector& end, AActor* target, AActor* ignoreTarget)
+{
+	check(IsInGameThread());
+
+	if ((end - start).Size() <= SMALL_NUMBER)
+	{
+		return;
+	}
+
+	World = gun->GetWorld();
+
+	SetupQueryParams(gun, ignoreTarget);
+
+	Handles.Emplace(World->AsyncLineTraceByChannel(EAsyncTraceType::Single, start, end, ABaseGameMode::ECC_LineOfSightTestIncVehicles, QueryParams));
+	Guns.Emplace(gun);
+	Targets.Emplace(target);
+	IgnoreTargets.Emplace(ignoreTarget);
+	Starts.Emplace(start);
+	Ends.Emplace(end);
+
+	INC_DWORD_STAT(STAT_GunRoundsFired);
+}
+
+/**
+* Apply the hits of all of the rounds fired by a gun right away.
+*
+* Rounds whose traces have completed use their results, and the rest are traced
+* synchronously, so that none of the rounds fired by the gun are lost.
+***********************************************************************************/
+
+void FGunRoundManager::FlushRounds(AGatlingGun* gun)
+{
+	check(IsInGameThread());
+
+	FTraceDatum data;
+
+	for (int32 i = Guns.Num() - 1; i >= 0; i--)
+	{
+		if (Guns[i].Get() == gun)
+		{
+			if (World->QueryTraceData(Handles[i], data) == true)
+			{
+				if (data.OutHits.Num() > 0)
+				{
+					ApplyRound(i, gun, data.OutHits[0]);
+				}
+			}
+			else
+			{
+				FHitResult hitResult;
+
+				SetupQueryParams(gun, IgnoreTargets[i].Get());
+
+				if (World->LineTraceSingleByChannel(hitResult, Starts[i], Ends[i], ABaseGameMode::ECC_LineOfSightTestIncVehicles, QueryParams) == true)
+				{
+					ApplyRound(i, gun, hitResult);
+				}
+			}
+
+			RemoveRound(i);
+		}
+	}
+}
+
+/**
+* Tick the manager, collecting the results of the traces for rounds and applying
+* their hits.
+***********************************************************************************/
+
+void FGunRoundManager::Tick()
+{
+	SCOPE_CYCLE_COUNTER(STAT_GunRoundsTick);
+
+	if (World == nullptr)
+	{
+		return;
+	}
+
+	FTraceDatum data;
+
+	for (int32 i = 0; i < Handles.Num(); )
+	{
+		AGatlingGun* gun = Guns[i].Get();
+
+		if (GRIP_OBJECT_VALID(gun) == false)
+		{
+			RemoveRound(i);
+		}
+		else if (World->QueryTraceData(Handles[i], data) == true)
+		{
+			if (data.OutHits.Num() > 0)
+			{
+				ApplyRound(i, gun, data.OutHits[0]);
+			}
+
+			RemoveRound(i);
+		}
+		else if (World->IsTraceHandleValid(Handles[i], false) == false)
+		{
+			// The trace has expired without its result being collected.
+
+			RemoveRound(i);
+		}
+		else
+		{
+			// The trace was only issued this frame, so its result will be available on
+			// the next one.
+
+			i++;
+		}
+	}
+
+	SET_DWORD_STAT(STAT_GunRoundsInFlight, Handles.Num());
+}
+
+/**
+* Setup the query parameters for tracing a round fired from a gun.
+***********************************************************************************/
+
+void FGunRoundManager::SetupQueryParams(AGatlingGun* gun, AActor* ignoreTarget)
+{
+	// The parameters are copied into the trace request, so we can just reset the
+	// ignored actors here rather than constructing new parameters for each round.
+
+	QueryParams.ClearIgnoredActors();
+	QueryParams.AddIgnoredActor(gun->GetLaunchPlatform());
+
+	if (ignoreTarget != nullptr)
+	{
+		QueryParams.AddIgnoredActor(ignoreTarget);
+	}
+}
+
+/**
+* Apply the hit of a round, if it hit anything.
+***********************************************************************************/
+
+void FGunRoundManager::ApplyRound(int32 index, AGatlingGun* gun, const FHitResult& hitResult)
+{
+	if (hitResult.bBlockingHit == true &&
+		hitResult.GetActor() != nullptr)
+	{
+		INC_DWORD_STAT(STAT_GunRoundsHit);
+
+		gun->RoundHit(hitResult, Starts[index], Ends[index], Targets[index].Get());
+	}
+}
+
+/**
+* Remove a round from the manager.
+***********************************************************************************/
+
+void FGunRoundManager::RemoveRound(int32 index)
+{
+	Handles.RemoveAtSwap(index, 1, false);
+	Guns.RemoveAtSwap(index, 1, false);
+	Targets.RemoveAtSwap(index, 1, false);
+	IgnoreTargets.RemoveAtSwap(index, 1, false);
+	Starts.RemoveAtSwap(index, 1, false);
+	Ends.RemoveAtSwap(index, 1, false);
+}
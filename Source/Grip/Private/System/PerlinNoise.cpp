@@ -9,6 +9,11 @@
 * 
 * An implementation of the Perlin noise technique, over 1, 2 or 3 dimensions.
 *
+* Noise can also be evaluated in batches, where the table lookups are done for
+* each coordinate but the remaining arithmetic is done for four coordinates at a
+* time using vector instructions, in exactly the same order as the single
+* coordinate versions so the results are identical.
+*
 ***********************************************************************************/
 
 #include "system/perlinnoise.h"
@@ -217,3 +222,260 @@ float FPerlinNoise::Noise3(float x, float y, float z) const
 
 	return v;
 }
+
+/**
+* Get some one dimensional noise for a batch of coordinates.
+***********************************************************************************/
+
+void FPerlinNoise::Noise1(const float* x, float* results, int32 count) const
+{
+	int32 i = 0;
+
+	for (; i + VectorWidth <= count; i += VectorWidth)
+	{
+		Noise1x4(x + i, results + i);
+	}
+
+	for (; i < count; i++)
+	{
+		results[i] = Noise1(x[i]);
+	}
+}
+
+/**
+* Get some two dimensional noise for a batch of coordinates.
+***********************************************************************************/
+
+void FPerlinNoise::Noise2(const float* x, const float* y, float* results, int32 count) const
+{
+	int32 i = 0;
+
+	for (; i + VectorWidth <= count; i += VectorWidth)
+	{
+		Noise2x4(x + i, y + i, results + i);
+	}
+
+	for (; i < count; i++)
+	{
+		results[i] = Noise2(x[i], y[i]);
+	}
+}
+
+/**
+* Get some three dimensional noise for a batch of coordinates.
+***********************************************************************************/
+
+void FPerlinNoise::Noise3(const float* x, const float* y, const float* z, float* results, int32 count) const
+{
+	int32 i = 0;
+
+	for (; i + VectorWidth <= count; i += VectorWidth)
+	{
+		Noise3x4(x + i, y + i, z + i, results + i);
+	}
+
+	for (; i < count; i++)
+	{
+		results[i] = Noise3(x[i], y[i], z[i]);
+	}
+}
+
+/**
+* Get four octaves of one dimensional noise summed together, each octave double
+* the frequency and half the amplitude of the last.
+***********************************************************************************/
+
+float FPerlinNoise::OctaveNoise1(float x) const
+{
+	float octaves[VectorWidth] = { x * 0.03125f, x * 0.0625f, x * 0.125f, x * 0.25f };
+	float heights[VectorWidth];
+
+	Noise1x4(octaves, heights);
+
+	float height = heights[0];
+
+	height += heights[1] * 0.5f;
+	height += heights[2] * 0.25f;
+	height += heights[3] * 0.125f;
+
+	return height;
+}
+
+/**
+* Get some one dimensional noise for four coordinates at once.
+*
+* The table lookups are done per coordinate, there being no gather in the vector
+* instructions available to us on all platforms. The floors are taken per
+* coordinate too, with FMath::FloorToInt just as in Noise1, so negative and
+* integral coordinates are handled identically. Multiplies and adds are never
+* fused, so the results are bit-identical to Noise1.
+***********************************************************************************/
+
+void FPerlinNoise::Noise1x4(const float* x, float* results) const
+{
+	int32 qx[VectorWidth];
+	VectorRegister vx = VectorLoad(x);
+	VectorRegister fx = Floor(x, qx);
+
+	VectorRegister gx0 = MakeVectorRegister(gx[qx[0] & MASK], gx[qx[1] & MASK], gx[qx[2] & MASK], gx[qx[3] & MASK]);
+	VectorRegister gx1 = MakeVectorRegister(gx[(qx[0] + 1) & MASK], gx[(qx[1] + 1) & MASK], gx[(qx[2] + 1) & MASK], gx[(qx[3] + 1) & MASK]);
+
+	const VectorRegister one = VectorOne();
+	const VectorRegister two = VectorSetFloat1(2.0f);
+	const VectorRegister three = VectorSetFloat1(3.0f);
+
+	VectorRegister tx0 = VectorSubtract(vx, fx);
+	VectorRegister tx1 = VectorSubtract(tx0, one);
+
+	// Compute the dot product between the vectors and the gradients
+
+	VectorRegister v0 = VectorMultiply(gx0, tx0);
+	VectorRegister v1 = VectorMultiply(gx1, tx1);
+
+	// Modulate with the weight function
+
+	VectorRegister wx = VectorMultiply(VectorMultiply(VectorSubtract(three, VectorMultiply(two, tx0)), tx0), tx0);
+
+	VectorStore(VectorSubtract(v0, VectorMultiply(wx, VectorSubtract(v0, v1))), results);
+}
+
+/**
+* Get some two dimensional noise for four coordinates at once.
+***********************************************************************************/
+
+void FPerlinNoise::Noise2x4(const float* x, const float* y, float* results) const
+{
+	int32 qx[VectorWidth], qy[VectorWidth];
+	int32 q00[VectorWidth], q01[VectorWidth], q10[VectorWidth], q11[VectorWidth];
+	VectorRegister vx = VectorLoad(x);
+	VectorRegister vy = VectorLoad(y);
+	VectorRegister fx = Floor(x, qx);
+	VectorRegister fy = Floor(y, qy);
+
+	for (int32 i = 0; i < VectorWidth; i++)
+	{
+		int32 qx0 = qx[i] & MASK;
+		int32 qx1 = (qx[i] + 1) & MASK;
+		int32 qy0 = qy[i] & MASK;
+		int32 qy1 = (qy[i] + 1) & MASK;
+
+		// Permutate values to get pseudo randomly chosen gradients
+
+		q00[i] = p[(qy0 + p[qx0]) & MASK];
+		q01[i] = p[(qy0 + p[qx1]) & MASK];
+
+		q10[i] = p[(qy1 + p[qx0]) & MASK];
+		q11[i] = p[(qy1 + p[qx1]) & MASK];
+	}
+
+	const VectorRegister one = VectorOne();
+	const VectorRegister two = VectorSetFloat1(2.0f);
+	const VectorRegister three = VectorSetFloat1(3.0f);
+
+	VectorRegister tx0 = VectorSubtract(vx, fx);
+	VectorRegister tx1 = VectorSubtract(tx0, one);
+
+	VectorRegister ty0 = VectorSubtract(vy, fy);
+	VectorRegister ty1 = VectorSubtract(ty0, one);
+
+	// Compute the dot product between the vectors and the gradients
+
+	VectorRegister v00 = VectorAdd(VectorMultiply(Gather(gx, q00), tx0), VectorMultiply(Gather(gy, q00), ty0));
+	VectorRegister v01 = VectorAdd(VectorMultiply(Gather(gx, q01), tx1), VectorMultiply(Gather(gy, q01), ty0));
+
+	VectorRegister v10 = VectorAdd(VectorMultiply(Gather(gx, q10), tx0), VectorMultiply(Gather(gy, q10), ty1));
+	VectorRegister v11 = VectorAdd(VectorMultiply(Gather(gx, q11), tx1), VectorMultiply(Gather(gy, q11), ty1));
+
+	// Modulate with the weight function
+
+	VectorRegister wx = VectorMultiply(VectorMultiply(VectorSubtract(three, VectorMultiply(two, tx0)), tx0), tx0);
+	VectorRegister v0 = VectorSubtract(v00, VectorMultiply(wx, VectorSubtract(v00, v01)));
+	VectorRegister v1 = VectorSubtract(v10, VectorMultiply(wx, VectorSubtract(v10, v11)));
+
+	VectorRegister wy = VectorMultiply(VectorMultiply(VectorSubtract(three, VectorMultiply(two, ty0)), ty0), ty0);
+
+	VectorStore(VectorSubtract(v0, VectorMultiply(wy, VectorSubtract(v0, v1))), results);
+}
+
+/**
+* Get some three dimensional noise for four coordinates at once.
+***********************************************************************************/
+
+void FPerlinNoise::Noise3x4(const float* x, const float* y, const float* z, float* results) const
+{
+	static const int32 NumCorners = 8;
+
+	int32 qx[VectorWidth], qy[VectorWidth], qz[VectorWidth];
+	int32 corners[NumCorners][VectorWidth];
+	VectorRegister vx = VectorLoad(x);
+	VectorRegister vy = VectorLoad(y);
+	VectorRegister vz = VectorLoad(z);
+	VectorRegister fx = Floor(x, qx);
+	VectorRegister fy = Floor(y, qy);
+	VectorRegister fz = Floor(z, qz);
+
+	for (int32 i = 0; i < VectorWidth; i++)
+	{
+		int32 qx0 = qx[i] & MASK;
+		int32 qx1 = (qx[i] + 1) & MASK;
+		int32 qy0 = qy[i] & MASK;
+		int32 qy1 = (qy[i] + 1) & MASK;
+		int32 qz0 = qz[i] & MASK;
+		int32 qz1 = (qz[i] + 1) & MASK;
+
+		// Permutate values to get pseudo randomly chosen gradients, the corners
+		// being ordered z, y, x as in Noise3.
+
+		corners[0][i] = p[(qz0 + p[(qy0 + p[qx0]) & MASK]) & MASK];
+		corners[1][i] = p[(qz0 + p[(qy0 + p[qx1]) & MASK]) & MASK];
+
+		corners[2][i] = p[(qz0 + p[(qy1 + p[qx0]) & MASK]) & MASK];
+		corners[3][i] = p[(qz0 + p[(qy1 + p[qx1]) & MASK]) & MASK];
+
+		corners[4][i] = p[(qz1 + p[(qy0 + p[qx0]) & MASK]) & MASK];
+		corners[5][i] = p[(qz1 + p[(qy0 + p[qx1]) & MASK]) & MASK];
+
+		corners[6][i] = p[(qz1 + p[(qy1 + p[qx0]) & MASK]) & MASK];
+		corners[7][i] = p[(qz1 + p[(qy1 + p[qx1]) & MASK]) & MASK];
+	}
+
+	const VectorRegister one = VectorOne();
+	const VectorRegister two = VectorSetFloat1(2.0f);
+	const VectorRegister three = VectorSetFloat1(3.0f);
+
+	VectorRegister tx[2], ty[2], tz[2];
+
+	tx[0] = VectorSubtract(vx, fx);
+	tx[1] = VectorSubtract(tx[0], one);
+
+	ty[0] = VectorSubtract(vy, fy);
+	ty[1] = VectorSubtract(ty[0], one);
+
+	tz[0] = VectorSubtract(vz, fz);
+	tz[1] = VectorSubtract(tz[0], one);
+
+	// Compute the dot product between the vectors and the gradients
+
+	VectorRegister v[NumCorners];
+
+	for (int32 c = 0; c < NumCorners; c++)
+	{
+		v[c] = VectorAdd(VectorAdd(VectorMultiply(Gather(gx, corners[c]), tx[c & 1]), VectorMultiply(Gather(gy, corners[c]), ty[(c >> 1) & 1])), VectorMultiply(Gather(gz, corners[c]), tz[c >> 2]));
+	}
+
+	// Modulate with the weight function
+
+	VectorRegister wx = VectorMultiply(VectorMultiply(VectorSubtract(three, VectorMultiply(two, tx[0])), tx[0]), tx[0]);
+	VectorRegister v00 = VectorSubtract(v[0], VectorMultiply(wx, VectorSubtract(v[0], v[1])));
+	VectorRegister v01 = VectorSubtract(v[2], VectorMultiply(wx, VectorSubtract(v[2], v[3])));
+	VectorRegister v10 = VectorSubtract(v[4], VectorMultiply(wx, VectorSubtract(v[4], v[5])));
+	VectorRegister v11 = VectorSubtract(v[6], VectorMultiply(wx, VectorSubtract(v[6], v[7])));
+
+	VectorRegister wy = VectorMultiply(VectorMultiply(VectorSubtract(three, VectorMultiply(two, ty[0])), ty[0]), ty[0]);
+	VectorRegister v0 = VectorSubtract(v00, VectorMultiply(wy, VectorSubtract(v00, v01)));
+	VectorRegister v1 = VectorSubtract(v10, VectorMultiply(wy, VectorSubtract(v10, v11)));
+
+	VectorRegister wz = VectorMultiply(VectorMultiply(VectorSubtract(three, VectorMultiply(two, tz[0])), tz[0]), tz[0]);
+
+	VectorStore(VectorSubtract(v0, VectorMultiply(wz, VectorSubtract(v0, v1))), results);
+}
@@ -0,0 +1,271 @@
+/**
+*
+* Perlin noise tests.
+*
+* Original author: Rob Baker.
+* Current maintainer: Rob Baker.
+*
+* Copyright Caged Element Inc, code provided for educational purposes only.
+*
+* Automation tests for the Perlin noise. The batch evaluation of the noise is
+* checked to be bit-identical to evaluating each coordinate on its own, including
+* the coordinates left over after the groups of four and negative and integral
+* coordinates. There's also a benchmark comparing the throughput of the two. Run
+* them with "Automation RunTests Grip.PerlinNoise" from the console, or from the
+* session frontend.
+*
+***********************************************************************************/
+
+#include "system/perlinnoise.h"
+#include "misc/automationtest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace PerlinNoiseTests
+{
+	/**
+	* Get the bits of a float, for comparing results exactly.
+	***********************************************************************************/
+
+	uint32 FloatBits(float value)
+	{
+		uint32 bits;
+
+		FMemory::Memcpy(&bits, &value, sizeof(bits));
+
+		return bits;
+	}
+
+	/**
+	* Make a set of coordinates to test, random across a range covering many
+	* repeats of the permutation table either side of zero, along with the awkward
+	* values of integers, values either side of them and zero of both signs. The
+	* awkward values are rotated by shift, so that they're mixed with different ones
+	* in each dimension.
+	***********************************************************************************/
+
+	void MakeCoordinates(FRandomStream& random, TArray<float>& coordinates, int32 count, int32 shift)
+	{
+		static const float specials[] = { 0.0f, -0.0f, 1.0f, -1.0f, 0.5f, -0.5f, 255.0f, -255.0f, 256.0f, -256.0f, 257.0f, -257.0f, 0.99999994f, -0.99999994f, 1.00000012f, -1.00000012f, 1.0e-7f, -1.0e-7f, 4095.75f, -4095.75f };
+		static const int32 numSpecials = sizeof(specials) / sizeof(specials[0]);
+
+		coordinates.Reset(count);
+
+		for (int32 i = 0; i < count; i++)
+		{
+			if (i < numSpecials)
+			{
+				coordinates.Emplace(specials[(i + shift) % numSpecials]);
+			}
+			else if (random.FRand() < 0.1f)
+			{
+				coordinates.Emplace((float)random.RandRange(-1000, 1000));
+			}
+			else
+			{
+				coordinates.Emplace(random.FRandRange(-1000.0f, 1000.0f));
+			}
+		}
+	}
+
+	/**
+	* Check that batch results match single coordinate results exactly, reporting
+	* the first mismatch.
+	***********************************************************************************/
+
+	bool CompareResults(FAutomationTestBase& test, const TCHAR* name, int32 offset, int32 count, const float* batch, const float* single)
+	{
+		for (int32 i = 0; i < count; i++)
+		{
+			if (FloatBits(batch[i]) != FloatBits(single[i]))
+			{
+				test.AddError(FString::Printf(TEXT("%s with %d coordinates from %d: coordinate %d gave %.9g in the batch but %.9g on its own"), name, count, offset, i, batch[i], single[i]));
+
+				return false;
+			}
+		}
+
+		return true;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FPerlinNoiseBatchTest, "Grip.PerlinNoise.Batch", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+/**
+* Check that the batch evaluation of Perlin noise is bit-identical to evaluating
+* each coordinate on its own.
+***********************************************************************************/
+
+bool FPerlinNoiseBatchTest::RunTest(const FString& parameters)
+{
+	using namespace PerlinNoiseTests;
+
+	const int32 maxCount = 1027;
+
+	FPerlinNoise noise;
+	FRandomStream random(0x5eed);
+	TArray<float> x, y, z, batch, single;
+
+	MakeCoordinates(random, x, maxCount, 0);
+	MakeCoordinates(random, y, maxCount, 7);
+	MakeCoordinates(random, z, maxCount, 13);
+
+	batch.SetNumZeroed(maxCount);
+	single.SetNumZeroed(maxCount);
+
+	bool result = true;
+
+	// Every batch size up to a few groups of four, so that every length of the
+	// remainder is covered, at every alignment of the coordinates, and then the
+	// whole lot.
+
+	TArray<TPair<int32, int32>> ranges;
+
+	for (int32 count = 0; count <= 13; count++)
+	{
+		for (int32 offset = 0; offset < FPerlinNoise::VectorWidth; offset++)
+		{
+			ranges.Emplace(offset, count);
+		}
+	}
+
+	ranges.Emplace(0, maxCount);
+
+	for (const TPair<int32, int32>& range : ranges)
+	{
+		int32 offset = range.Key;
+		int32 count = range.Value;
+
+		noise.Noise1(&x[offset], batch.GetData(), count);
+
+		for (int32 i = 0; i < count; i++)
+		{
+			single[i] = noise.Noise1(x[offset + i]);
+		}
+
+		result &= CompareResults(*this, TEXT("Noise1"), offset, count, batch.GetData(), single.GetData());
+
+		noise.Noise2(&x[offset], &y[offset], batch.GetData(), count);
+
+		for (int32 i = 0; i < count; i++)
+		{
+			single[i] = noise.Noise2(x[offset + i], y[offset + i]);
+		}
+
+		result &= CompareResults(*this, TEXT("Noise2"), offset, count, batch.GetData(), single.GetData());
+
+		noise.Noise3(&x[offset], &y[offset], &z[offset], batch.GetData(), count);
+
+		for (int32 i = 0; i < count; i++)
+		{
+			single[i] = noise.Noise3(x[offset + i], y[offset + i], z[offset + i]);
+		}
+
+		result &= CompareResults(*this, TEXT("Noise3"), offset, count, batch.GetData(), single.GetData());
+	}
+
+	// The octave noise evaluates its four octaves as a batch, so check it against
+	// summing the octaves one at a time.
+
+	for (int32 i = 0; i < maxCount; i++)
+	{
+		float coordinate = x[i] * 100.0f;
+		float height = noise.Noise1(coordinate * 0.03125f);
+
+		height += noise.Noise1(coordinate * 0.0625f) * 0.5f;
+		height += noise.Noise1(coordinate * 0.125f) * 0.25f;
+		height += noise.Noise1(coordinate * 0.25f) * 0.125f;
+
+		float octaves = noise.OctaveNoise1(coordinate);
+
+		result &= CompareResults(*this, TEXT("OctaveNoise1"), i, 1, &octaves, &height);
+	}
+
+	return result;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FPerlinNoiseBatchBenchmark, "Grip.PerlinNoise.BatchBenchmark", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+/**
+* Benchmark the batch evaluation of Perlin noise against evaluating each
+* coordinate on its own.
+***********************************************************************************/
+
+bool FPerlinNoiseBatchBenchmark::RunTest(const FString& parameters)
+{
+	using namespace PerlinNoiseTests;
+
+	const int32 count = 4096;
+	const int32 numRepeats = 500;
+	const double numCoordinates = (double)count * numRepeats;
+
+	FPerlinNoise noise;
+	FRandomStream random(0x5eed);
+	TArray<float> x, y, z, results;
+	float checksum = 0.0f;
+
+	MakeCoordinates(random, x, count, 0);
+	MakeCoordinates(random, y, count, 7);
+	MakeCoordinates(random, z, count, 13);
+
+	results.SetNumZeroed(count);
+
+	double times[3][2];
+
+	for (int32 dimensions = 1; dimensions <= 3; dimensions++)
+	{
+		for (int32 batched = 0; batched < 2; batched++)
+		{
+			double startTime = FPlatformTime::Seconds();
+
+			for (int32 repeat = 0; repeat < numRepeats; repeat++)
+			{
+				if (batched == 1)
+				{
+					switch (dimensions)
+					{
+					case 1:
+						noise.Noise1(x.GetData(), results.GetData(), count);
+						break;
+					case 2:
+						noise.Noise2(x.GetData(), y.GetData(), results.GetData(), count);
+						break;
+					default:
+						noise.Noise3(x.GetData(), y.GetData(), z.GetData(), results.GetData(), count);
+						break;
+					}
+				}
+				else
+				{
+					for (int32 i = 0; i < count; i++)
+					{
+						switch (dimensions)
+						{
+						case 1:
+							results[i] = noise.Noise1(x[i]);
+							break;
+						case 2:
+							results[i] = noise.Noise2(x[i], y[i]);
+							break;
+						default:
+							results[i] = noise.Noise3(x[i], y[i], z[i]);
+							break;
+						}
+					}
+				}
+
+				checksum += results[repeat % count];
+			}
+
+			times[dimensions - 1][batched] = (FPlatformTime::Seconds() - startTime) * 1.0e9 / numCoordinates;
+		}
+
+		AddInfo(FString::Printf(TEXT("Noise%d: single %.2fns, batch %.2fns per coordinate"), dimensions, times[dimensions - 1][0], times[dimensions - 1][1]));
+	}
+
+	// Use the results so the evaluation can't be optimized away.
+
+	return TestTrue(TEXT("Checksum is finite"), FMath::IsFinite(checksum));
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
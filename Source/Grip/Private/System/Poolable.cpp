@@ -0,0 +1,24 @@
+/**
+*
+* Poolable interface.
+*
+* Original author: Rob Baker.
+* Current maintainer: Rob Baker.
+*
+* Copyright Caged Element Inc, code provided for educational purposes only.
+*
+* An interface to use for actors that can be recycled through the actor pool
+* rather than being spawned and destroyed each time they're used.
+*
+***********************************************************************************/
+
+#include "system/poolable.h"
+
+/**
+* Construct a UPoolableInterface.
+***********************************************************************************/
+
+UPoolableInterface::UPoolableInterface(const FObjectInitializer& objectInitializer)
+	: Super(objectInitializer)
+{
+}
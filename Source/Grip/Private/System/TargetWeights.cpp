@@ -0,0 +1,115 @@
+/**
+*
+* Batched target weighting.
+*
+* Original author: Rob Baker.
+* Current maintainer: Rob Baker.
+*
+* Copyright Caged Element Inc, code provided for educational purposes only.
+*
+* Target selection for the offensive pickups weighs every candidate vehicle with
+* FMathEx::TargetWeight, each of which takes a square root, a normalization and an
+* arc cosine. Most candidates are out of range or outside of the cone though, so
+* here the candidate positions are held in structure-of-arrays form and culled by
+* range and cone four at a time using vector instructions, comparing squared
+* quantities so that no square roots are needed. Only the survivors go on to have
+* their weight calculated, in exactly the same way as TargetWeight.
+*
+***********************************************************************************/
+
+#include "system/targetweights.h"
+#include "system/mathhelpers.h"
+
+/**
+* Compute the weights of all of the candidates.
+*
+* With d being the offset to a candidate, the range test is minDistance < |d| <
+* maxDistance, done here on the squared lengths. The cone test is
+* dot(direction, d) > maxCosAngle * |d|, which for a positive maxCosAngle means
+* the dot product must be positive and its square greater than maxCosAngle
+* squared times |d| squared. For a negative maxCosAngle, either the dot product
+* is positive, or its square is less than that same product.
+***********************************************************************************/
+
+void FTargetWeights::Compute(const FVector& fromPosition, const FVector& fromDirection, float minDistance, float maxDistance, float maxCosAngle, bool weightAngle)
+{
+	int32 numCandidates = Weights.Num();
+
+	if (numCandidates == 0)
+	{
+		return;
+	}
+
+	// Pad the candidates up to the vector width with the source position, which is
+	// never within range.
+
+	int32 size = Align(numCandidates, VectorWidth);
+
+	for (int32 i = numCandidates; i < size; i++)
+	{
+		X.Emplace(fromPosition.X);
+		Y.Emplace(fromPosition.Y);
+		Z.Emplace(fromPosition.Z);
+	}
+
+	Weights.Init(-1.0f, size);
+
+	const VectorRegister zero = VectorZero();
+	const VectorRegister px = VectorSetFloat1(fromPosition.X);
+	const VectorRegister py = VectorSetFloat1(fromPosition.Y);
+	const VectorRegister pz = VectorSetFloat1(fromPosition.Z);
+	const VectorRegister dx = VectorSetFloat1(fromDirection.X);
+	const VectorRegister dy = VectorSetFloat1(fromDirection.Y);
+	const VectorRegister dz = VectorSetFloat1(fromDirection.Z);
+	const VectorRegister minDistanceSquared = VectorSetFloat1(minDistance * minDistance);
+	const VectorRegister maxDistanceSquared = VectorSetFloat1(maxDistance * maxDistance);
+	const VectorRegister maxCosSquared = VectorSetFloat1(maxCosAngle * maxCosAngle);
+
+	float inCone[VectorWidth];
+
+	for (int32 i = 0; i < size; i += VectorWidth)
+	{
+		VectorRegister ox = VectorSubtract(VectorLoad(&X[i]), px);
+		VectorRegister oy = VectorSubtract(VectorLoad(&Y[i]), py);
+		VectorRegister oz = VectorSubtract(VectorLoad(&Z[i]), pz);
+
+		VectorRegister distanceSquared = VectorMultiplyAdd(oz, oz, VectorMultiplyAdd(oy, oy, VectorMultiply(ox, ox)));
+		VectorRegister dotProduct = VectorMultiplyAdd(oz, dz, VectorMultiplyAdd(oy, dy, VectorMultiply(ox, dx)));
+		VectorRegister coneSquared = VectorMultiply(maxCosSquared, distanceSquared);
+		VectorRegister dotSquared = VectorMultiply(dotProduct, dotProduct);
+		VectorRegister forwards = VectorCompareGT(dotProduct, zero);
+
+		VectorRegister valid = VectorBitwiseAnd(VectorCompareGT(distanceSquared, minDistanceSquared), VectorCompareLT(distanceSquared, maxDistanceSquared));
+
+		if (maxCosAngle >= 0.0f)
+		{
+			valid = VectorBitwiseAnd(valid, VectorBitwiseAnd(forwards, VectorCompareGT(dotSquared, coneSquared)));
+		}
+		else
+		{
+			valid = VectorBitwiseAnd(valid, VectorBitwiseOr(forwards, VectorCompareLT(dotSquared, coneSquared)));
+		}
+
+		if (VectorMaskBits(valid) != 0)
+		{
+			VectorStore(VectorSelect(valid, VectorOne(), zero), inCone);
+
+			for (int32 j = 0; j < VectorWidth; j++)
+			{
+				if (inCone[j] != 0.0f)
+				{
+					// Exactly the same calculation as TargetWeight, so the results are identical.
+
+					Weights[i + j] = FMathEx::TargetWeight(fromPosition, fromDirection, FVector(X[i + j], Y[i + j], Z[i + j]), minDistance, maxDistance, maxCosAngle, weightAngle);
+				}
+			}
+		}
+	}
+
+	// Remove the padding.
+
+	X.SetNum(numCandidates, false);
+	Y.SetNum(numCandidates, false);
+	Z.SetNum(numCandidates, false);
+	Weights.SetNum(numCandidates, false);
+}
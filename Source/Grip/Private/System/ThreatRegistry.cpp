@@ -0,0 +1,82 @@
+/**
+*
+* Fleet-wide registry of incoming threats.
+*
+* Original author: Rob Baker.
+* Current maintainer: Rob Baker.
+*
+* Copyright Caged Element Inc, code provided for educational purposes only.
+*
+* The AI bots, the HUD warnings and the cinematic cameras all want to know which
+* missiles are incoming on which vehicles, and how soon they'll hit. Rather than
+* each of them scanning all of the missiles in the game and estimating the time
+* to impact for themselves, the registry does this once per frame and keeps, for
+* each target vehicle, a small list of its incoming threats sorted by time to
+* impact.
+*
+***********************************************************************************/
+
+#include "system/threatregistry.h"
+#include "pickups/homingmissile.h"
+#include "vehicle/basevehicle.h"
+
+/**
+* An empty list of threats, for vehicles that don't have any.
+***********************************************************************************/
+
+const FThreatRegistry::FThreatList FThreatRegistry::NoThreats;
+
+/**
+* Update the registry from the missiles currently present in the game.
+***********************************************************************************/
+
+void FThreatRegistry::Update(const TArray<AHomingMissile*>& missiles)
+{
+	for (FThreatList& threats : Threats)
+	{
+		threats.Reset();
+	}
+
+	for (AHomingMissile* missile : missiles)
+	{
+		if (GRIP_OBJECT_VALID(missile) == false ||
+			missile->HasExploded() == true)
+		{
+			continue;
+		}
+
+		ABaseVehicle* vehicle = Cast<ABaseVehicle>(missile->Target);
+		int32 vehicleIndex = (vehicle != nullptr) ? vehicle->GetVehicleIndex() : INDEX_NONE;
+
+		if (vehicleIndex < 0)
+		{
+			continue;
+		}
+
+		if (Threats.Num() <= vehicleIndex)
+		{
+			Threats.SetNum(vehicleIndex + 1);
+		}
+
+		FIncomingThreat& threat = Threats[vehicleIndex].AddDefaulted_GetRef();
+
+		threat.Missile = missile;
+		threat.TimeToTarget = missile->GetTimeToTarget();
+		threat.Distance = (missile->GetActorLocation() - vehicle->GetActorLocation()).Size();
+		threat.Homing = missile->IsHoming();
+		threat.Locked = missile->IsTargeting(vehicle);
+		threat.LikelyToHit = missile->IsLikelyToHitTarget();
+		threat.WithinReach = missile->IsTargetWithinReach();
+	}
+
+	for (FThreatList& threats : Threats)
+	{
+		if (threats.Num() > 1)
+		{
+			threats.Sort([] (const FIncomingThreat& object1, const FIncomingThreat& object2)
+				{
+					return object1.TimeToTarget < object2.TimeToTarget;
+				});
+		}
+	}
+}
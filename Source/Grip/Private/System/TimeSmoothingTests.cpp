@@ -0,0 +1,263 @@
+/**
+*
+* Timed value list tests.
+*
+* Original author: Rob Baker.
+* Current maintainer: Rob Baker.
+*
+* Copyright Caged Element Inc, code provided for educational purposes only.
+*
+* Automation tests for the timed value lists. The window statistics are checked
+* against the same list without them, which scans every value for each query, for
+* the kinds of list that the game uses. There's also a benchmark comparing the
+* cost of the two for a frame's worth of adding and querying. Run them with
+* "Automation RunTests Grip.TimeSmoothing" from the console, or from the session
+* frontend.
+*
+***********************************************************************************/
+
+#include "system/timesmoothing.h"
+#include "misc/automationtest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace TimeSmoothingTests
+{
+	/**
+	* Check that two lists hold the same values and give the same answers to all of
+	* the queries.
+	***********************************************************************************/
+
+	template<typename ListType>
+	bool CompareLists(FAutomationTestBase& test, const TCHAR* name, int32 frame, const ListType& window, const ListType& scanned)
+	{
+		if (window.GetNumValues() != scanned.GetNumValues())
+		{
+			test.AddError(FString::Printf(TEXT("%s frame %d: %d values against %d"), name, frame, window.GetNumValues(), scanned.GetNumValues()));
+
+			return false;
+		}
+
+		int32 numValues = window.GetNumValues();
+
+		if (numValues == 0)
+		{
+			return true;
+		}
+
+		float absSum = 0.0f;
+
+		for (int32 i = 0; i < numValues; i++)
+		{
+			if (window[i].Time != scanned[i].Time ||
+				window[i].Value != scanned[i].Value)
+			{
+				test.AddError(FString::Printf(TEXT("%s frame %d: value %d differs"), name, frame, i));
+
+				return false;
+			}
+
+			absSum += FMath::Abs(window[i].Value);
+		}
+
+		// The minimum and maximum must be exact, the sums can differ by the rounding
+		// of the running sums, which are recalculated each time the buffer wraps.
+
+		float sumTolerance = FMath::Max(1.0f, absSum) * 1.0e-4f;
+		float meanTolerance = FMath::Max(1.0f, absSum / numValues) * 1.0e-4f;
+		bool result = true;
+
+		// Querying since the oldest value is answered from the window statistics just
+		// like querying all of them.
+
+		for (float since : { -1.0f, window[0].Time })
+		{
+			result &= test.TestEqual(*FString::Printf(TEXT("%s frame %d: minimum since %f"), name, frame, since), window.GetMinValue(since), scanned.GetMinValue(since));
+			result &= test.TestEqual(*FString::Printf(TEXT("%s frame %d: maximum since %f"), name, frame, since), window.GetMaxValue(since), scanned.GetMaxValue(since));
+			result &= test.TestEqual(*FString::Printf(TEXT("%s frame %d: mean since %f"), name, frame, since), window.GetMeanValue(since), scanned.GetMeanValue(since), meanTolerance);
+			result &= test.TestEqual(*FString::Printf(TEXT("%s frame %d: absolute mean since %f"), name, frame, since), window.GetAbsMeanValue(since), scanned.GetAbsMeanValue(since), meanTolerance);
+			result &= test.TestEqual(*FString::Printf(TEXT("%s frame %d: lower unfluttered since %f"), name, frame, since), window.GetUnflutteredValue(since, false), scanned.GetUnflutteredValue(since, false), meanTolerance);
+			result &= test.TestEqual(*FString::Printf(TEXT("%s frame %d: higher unfluttered since %f"), name, frame, since), window.GetUnflutteredValue(since, true), scanned.GetUnflutteredValue(since, true), meanTolerance);
+			result &= test.TestEqual(*FString::Printf(TEXT("%s frame %d: sum since %f"), name, frame, since), window.GetSumValue(since), scanned.GetSumValue(since), sumTolerance);
+			result &= test.TestEqual(*FString::Printf(TEXT("%s frame %d: absolute sum since %f"), name, frame, since), window.GetAbsSumValue(since), scanned.GetAbsSumValue(since), sumTolerance);
+		}
+
+		result &= test.TestEqual(*FString::Printf(TEXT("%s frame %d: scaled mean"), name, frame), window.GetScaledMeanValue(), scanned.GetScaledMeanValue(), meanTolerance);
+		result &= test.TestEqual(*FString::Printf(TEXT("%s frame %d: absolute scaled mean"), name, frame), window.GetAbsScaledMeanValue(), scanned.GetAbsScaledMeanValue(), meanTolerance);
+
+		// Querying since part way through the list isn't a window query, so is scanned
+		// for both lists, but check it all the same.
+
+		float since = window[numValues / 2].Time;
+
+		result &= test.TestEqual(*FString::Printf(TEXT("%s frame %d: minimum since %f"), name, frame, since), window.GetMinValue(since), scanned.GetMinValue(since));
+		result &= test.TestEqual(*FString::Printf(TEXT("%s frame %d: maximum since %f"), name, frame, since), window.GetMaxValue(since), scanned.GetMaxValue(since));
+
+		return result;
+	}
+
+	/**
+	* Feed a list with and without window statistics with the same values over a
+	* number of frames, comparing them after each one.
+	*
+	* The values are random, but held to the same sign for random periods so that the
+	* lists see both runs of values and values that flutter around zero.
+	***********************************************************************************/
+
+	template<int32 Capacity>
+	bool TestList(FAutomationTestBase& test, const TCHAR* name, int32 maxSeconds, int32 samplesPerSecond, bool averageSamples, bool sumSamples, int32 numFrames)
+	{
+		TTimedValueList<float, Capacity> window(maxSeconds, samplesPerSecond, averageSamples, sumSamples, true);
+		TTimedValueList<float, Capacity> scanned(maxSeconds, samplesPerSecond, averageSamples, sumSamples, false);
+		FRandomStream random(numFrames);
+		float sign = 1.0f;
+		bool result = true;
+
+		for (int32 frame = 0; frame < numFrames && result == true; frame++)
+		{
+			// A variable frame rate of around 60 frames per second.
+
+			float time = frame / 60.0f + random.FRandRange(0.0f, 0.01f);
+
+			if (random.FRand() < 0.05f)
+			{
+				sign *= -1.0f;
+			}
+
+			float value = (random.FRand() < 0.75f) ? sign * random.FRandRange(0.0f, 100.0f) : random.FRandRange(-100.0f, 100.0f);
+
+			// Every now and then, a value that's exactly zero or a repeat of the last one,
+			// to check that ties in the minimum and maximum queues are handled.
+
+			if (random.FRand() < 0.02f)
+			{
+				value = 0.0f;
+			}
+			else if (random.FRand() < 0.05f)
+			{
+				value = window.GetLastValue();
+			}
+
+			window.AddValue(time, value);
+			scanned.AddValue(time, value);
+
+			// Occasionally clear some or all of the values, as the game does on resets.
+
+			if (random.FRand() < 0.001f)
+			{
+				window.Clear();
+				scanned.Clear();
+			}
+			else if (random.FRand() < 0.002f &&
+				window.GetNumValues() > 0)
+			{
+				float clearTime = window[window.GetNumValues() / 2].Time;
+
+				window.Clear(clearTime);
+				scanned.Clear(clearTime);
+			}
+
+			result &= CompareLists(test, name, frame, window, scanned);
+		}
+
+		return result;
+	}
+
+	/**
+	* Measure the time in nanoseconds per frame to add a value and query a list in the
+	* way that the game does.
+	***********************************************************************************/
+
+	template<int32 Capacity>
+	double BenchmarkList(int32 maxSeconds, int32 samplesPerSecond, bool windowStatistics, int32 numFrames, float& checksum)
+	{
+		TTimedValueList<float, Capacity> list(maxSeconds, samplesPerSecond, true, false, windowStatistics);
+		FRandomStream random(numFrames);
+
+		// Get the list filled before we start timing.
+
+		int32 numWarmupFrames = maxSeconds * 60 * 2;
+
+		for (int32 frame = 0; frame < numWarmupFrames; frame++)
+		{
+			list.AddValue(frame / 60.0f, random.FRandRange(-100.0f, 100.0f));
+		}
+
+		double startTime = FPlatformTime::Seconds();
+
+		for (int32 frame = numWarmupFrames; frame < numWarmupFrames + numFrames; frame++)
+		{
+			list.AddValue(frame / 60.0f, random.FRandRange(-100.0f, 100.0f));
+
+			checksum += list.GetMeanValue() + list.GetMinValue() + list.GetMaxValue() + list.GetUnflutteredValue();
+		}
+
+		return (FPlatformTime::Seconds() - startTime) * 1.0e9 / numFrames;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FTimedValueListWindowStatisticsTest, "Grip.TimeSmoothing.WindowStatistics", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+/**
+* Check the window statistics of timed value lists against scanning the values,
+* for the kinds of list that the game uses.
+***********************************************************************************/
+
+bool FTimedValueListWindowStatisticsTest::RunTest(const FString& parameters)
+{
+	using namespace TimeSmoothingTests;
+
+	bool result = true;
+
+	// Like the frame times in the play game mode.
+
+	result &= TestList<32>(*this, TEXT("Frame times"), 1, 30, true, false, 10000);
+
+	// Like the AI thrust used for stuck detection.
+
+	result &= TestList<1024>(*this, TEXT("AI thrust"), 21, 30, true, false, 10000);
+
+	// Summing samples, like the physics pitch change.
+
+	result &= TestList<256>(*this, TEXT("Summed"), 10, 25, false, true, 10000);
+
+	// Point-sampling, neither averaging nor summing.
+
+	result &= TestList<64>(*this, TEXT("Point sampled"), 5, 10, false, false, 10000);
+
+	// No fixed sample rate, just holding values for the last second, on the heap.
+
+	result &= TestList<0>(*this, TEXT("Unsampled"), 1, 0, true, false, 10000);
+
+	return result;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FTimedValueListWindowStatisticsBenchmark, "Grip.TimeSmoothing.WindowStatisticsBenchmark", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+/**
+* Benchmark the window statistics of timed value lists against scanning the values,
+* adding a value and asking for the mean, minimum, maximum and unfluttered value
+* each frame.
+***********************************************************************************/
+
+bool FTimedValueListWindowStatisticsBenchmark::RunTest(const FString& parameters)
+{
+	using namespace TimeSmoothingTests;
+
+	const int32 numFrames = 200000;
+	float checksum = 0.0f;
+
+	double frameTimesScanned = BenchmarkList<32>(1, 30, false, numFrames, checksum);
+	double frameTimesWindow = BenchmarkList<32>(1, 30, true, numFrames, checksum);
+	double thrustScanned = BenchmarkList<1024>(21, 30, false, numFrames, checksum);
+	double thrustWindow = BenchmarkList<1024>(21, 30, true, numFrames, checksum);
+
+	AddInfo(FString::Printf(TEXT("Frame times, 30 values: scanned %.1fns, window %.1fns per frame"), frameTimesScanned, frameTimesWindow));
+	AddInfo(FString::Printf(TEXT("AI thrust, 630 values: scanned %.1fns, window %.1fns per frame"), thrustScanned, thrustWindow));
+
+	// Use the results so the queries can't be optimized away.
+
+	return TestTrue(TEXT("Checksum is finite"), FMath::IsFinite(checksum));
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
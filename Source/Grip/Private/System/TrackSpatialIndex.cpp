@@ -0,0 +1,24 @@
+/**
+*
+* Spatial index of objects along the master racing spline.
+*
+* Original author: Rob Baker.
+* Current maintainer: Rob Baker.
+*
+* Copyright Caged Element Inc, code provided for educational purposes only.
+*
+* AI bots are only ever interested in objects that lie within a window along their
+* route, so rather than scanning every attractable or avoidable in the level, the
+* objects are kept sorted by their distance along the master racing spline, along
+* with their lateral offset from it. Queries then only visit the objects within
+* the window requested, found with a binary search.
+*
+***********************************************************************************/
+
+#include "system/trackspatialindex.h"
+
+DEFINE_STAT(STAT_TrackSpatialIndexUpdate);
+DEFINE_STAT(STAT_TrackSpatialIndexQuery);
+DEFINE_STAT(STAT_TrackSpatialIndexQueries);
+DEFINE_STAT(STAT_TrackSpatialIndexCandidates);
+DEFINE_STAT(STAT_TrackSpatialIndexSkipped);
@@ -0,0 +1,238 @@
+/**
+*
+* Proximity broadphase for vehicle-to-vehicle queries.
+*
+* Original author: Rob Baker.
+* Current maintainer: Rob Baker.
+*
+* Copyright Caged Element Inc, code provided for educational purposes only.
+*
+* Lots of systems need to know which vehicles are near a location, or within a
+* cone in front of it, or close by in the race. Rather than each of them looping
+* over every vehicle in the game, the broadphase is built once per frame with the
+* vehicles sorted by race distance and bucketed into a uniform grid over their
+* bounds, so that queries only need to look at the vehicles nearby.
+*
+***********************************************************************************/
+
+#include "system/vehiclebroadphase.h"
+#include "vehicle/basevehicle.h"
+#include "algo/binarysearch.h"
+
+/**
+* The size of each grid cell, in centimeters.
+***********************************************************************************/
+
+const float FVehicleBroadphase::CellSize = 50.0f * 100.0f;
+
+/**
+* Build the broadphase from a list of vehicles.
+***********************************************************************************/
+
+void FVehicleBroadphase::Build(const TArray<ABaseVehicle*>& vehicles, float deltaSeconds)
+{
+	Entries.Reset();
+	VehiclesByRaceDistance.Reset();
+	Bounds = FBox(ForceInit);
+
+	float maxRadius = 0.0f;
+	float maxSpeed = 0.0f;
+
+	for (ABaseVehicle* vehicle : vehicles)
+	{
+		FVehicleEntry& entry = Entries.AddDefaulted_GetRef();
+
+		entry.Vehicle = vehicle;
+		entry.Location = vehicle->GetActorLocation();
+		entry.RaceDistance = vehicle->GetRaceState().EternalRaceDistance;
+
+		Bounds += entry.Location;
+
+		maxRadius = FMath::Max(maxRadius, FMath::Max(vehicle->VehicleMesh->Bounds.SphereRadius, vehicle->CameraClipBox.Max.Size()));
+		maxSpeed = FMath::Max(maxSpeed, vehicle->GetVelocity().Size());
+	}
+
+	// Queries are made against where vehicles were when the broadphase was built, which
+	// is normally at the end of the last frame, so allow for them moving for a couple of
+	// frames as well as for their size.
+
+	Padding = maxRadius + (maxSpeed * deltaSeconds * 2.0f);
+
+	// Break ties on the vehicle index so that the order is always the same for the same state.
+
+	Entries.Sort([] (const FVehicleEntry& object1, const FVehicleEntry& object2)
+		{
+			return (object1.RaceDistance != object2.RaceDistance) ? object1.RaceDistance < object2.RaceDistance : object1.Vehicle->GetVehicleIndex() < object2.Vehicle->GetVehicleIndex();
+		});
+
+	for (const FVehicleEntry& entry : Entries)
+	{
+		VehiclesByRaceDistance.Emplace(entry.Vehicle);
+	}
+
+	// Now bucket the vehicles into a uniform grid, enlarging the cells if necessary to
+	// keep the grid to a sensible size.
+
+	FVector extent = (Entries.Num() > 0) ? Bounds.GetSize() : FVector::ZeroVector;
+	float cellSize = FMath::Max(CellSize, FMath::Max(extent.X, extent.Y) / (float)MaxGridCells);
+
+	InvCellSize = 1.0f / cellSize;
+	GridWidth = FMath::Clamp(FMath::CeilToInt(extent.X * InvCellSize), 1, MaxGridCells);
+	GridHeight = FMath::Clamp(FMath::CeilToInt(extent.Y * InvCellSize), 1, MaxGridCells);
+
+	int32 numCells = GridWidth * GridHeight;
+
+	CellStarts.Reset();
+	CellStarts.AddZeroed(numCells + 1);
+	CellEntries.SetNumUninitialized(Entries.Num(), false);
+
+	TArray<int32, TInlineAllocator<16>> entryCells;
+
+	for (const FVehicleEntry& entry : Entries)
+	{
+		int32 cell = GetCellY(entry.Location.Y) * GridWidth + GetCellX(entry.Location.X);
+
+		entryCells.Emplace(cell);
+		CellStarts[cell + 1]++;
+	}
+
+	for (int32 i = 0; i < numCells; i++)
+	{
+		CellStarts[i + 1] += CellStarts[i];
+	}
+
+	// Entries are placed into the cells in race distance order, so each cell is sorted.
+
+	TArray<int32, TInlineAllocator<256>> cellCursors;
+
+	cellCursors.Append(CellStarts.GetData(), numCells);
+
+	for (int32 i = 0; i < Entries.Num(); i++)
+	{
+		CellEntries[cellCursors[entryCells[i]]++] = i;
+	}
+}
+
+/**
+* Gather the indices of the entries in the grid cells overlapping a sphere, in race
+* distance order.
+***********************************************************************************/
+
+void FVehicleBroadphase::GatherCandidates(const FVector& location, float radius, TArray<int32, TInlineAllocator<16>>& candidates) const
+{
+	candidates.Reset();
+
+	if (Entries.Num() == 0)
+	{
+		return;
+	}
+
+	int32 x0 = GetCellX(location.X - radius);
+	int32 x1 = GetCellX(location.X + radius);
+	int32 y0 = GetCellY(location.Y - radius);
+	int32 y1 = GetCellY(location.Y + radius);
+
+	for (int32 y = y0; y <= y1; y++)
+	{
+		for (int32 x = x0; x <= x1; x++)
+		{
+			int32 cell = y * GridWidth + x;
+
+			for (int32 i = CellStarts[cell]; i < CellStarts[cell + 1]; i++)
+			{
+				candidates.Emplace(CellEntries[i]);
+			}
+		}
+	}
+
+	// Return the results in race distance order, so queries are deterministic no matter
+	// how the vehicles fell into the grid.
+
+	candidates.Sort();
+}
+
+/**
+* Get the vehicles that may be within radius of a location.
+***********************************************************************************/
+
+void FVehicleBroadphase::QueryNeighbours(const FVector& location, float radius, FVehicleList& results) const
+{
+	TArray<int32, TInlineAllocator<16>> candidates;
+
+	radius += Padding;
+
+	GatherCandidates(location, radius, candidates);
+
+	results.Reset();
+
+	for (int32 index : candidates)
+	{
+		const FVehicleEntry& entry = Entries[index];
+
+		if ((entry.Location - location).SizeSquared() <= radius * radius)
+		{
+			results.Emplace(entry.Vehicle);
+		}
+	}
+}
+
+/**
+* Get the vehicles that may be within maxDistance of a location and inside a cone
+* around a direction, where minCosAngle is the cosine of the half-angle of the cone.
+***********************************************************************************/
+
+void FVehicleBroadphase::QueryCone(const FVector& location, const FVector& direction, float maxDistance, float minCosAngle, FVehicleList& results) const
+{
+	TArray<int32, TInlineAllocator<16>> candidates;
+
+	maxDistance += Padding;
+
+	GatherCandidates(location, maxDistance, candidates);
+
+	results.Reset();
+
+	float coneAngle = FMath::Acos(FMath::Clamp(minCosAngle, -1.0f, 1.0f));
+
+	for (int32 index : candidates)
+	{
+		const FVehicleEntry& entry = Entries[index];
+		FVector difference = entry.Location - location;
+		float distance = difference.Size();
+
+		if (distance > maxDistance)
+		{
+			continue;
+		}
+
+		if (distance > Padding)
+		{
+			// Widen the cone by the angle subtended by the padding at the vehicle's distance,
+			// so that a sphere around the vehicle of that size is tested against the cone.
+
+			float angle = FMath::Min(PI, coneAngle + FMath::Asin(Padding / distance));
+
+			if (FVector::DotProduct(difference, direction) < FMath::Cos(angle) * distance)
+			{
+				continue;
+			}
+		}
+
+		results.Emplace(entry.Vehicle);
+	}
+}
+
+/**
+* Get the vehicles whose eternal race distance is between two distances.
+***********************************************************************************/
+
+void FVehicleBroadphase::QueryRaceDistance(float fromDistance, float toDistance, FVehicleList& results) const
+{
+	results.Reset();
+
+	int32 index = Algo::LowerBoundBy(Entries, fromDistance, [] (const FVehicleEntry& entry) { return entry.RaceDistance; });
+
+	for (; index < Entries.Num() && Entries[index].RaceDistance <= toDistance; index++)
+	{
+		results.Emplace(Entries[index].Vehicle);
+	}
+}
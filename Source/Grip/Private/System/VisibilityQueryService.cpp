@@ -0,0 +1,203 @@
+/**
+*
+* Asynchronous line-of-sight query service.
+*
+* Original author: Rob Baker.
+* Current maintainer: Rob Baker.
+*
+* Copyright Caged Element Inc, code provided for educational purposes only.
+*
+* Lots of systems, like targeting, the AI bots and the cinematic cameras, need to
+* know whether one thing can see another, and most of them can tolerate knowing a
+* frame late. Rather than each of them performing synchronous line traces on the
+* game thread, the service issues asynchronous traces through the engine, picks
+* up their results on the next frame, and caches them per source and target pair
+* for as long as the caller considers them valid and the end points of the trace
+* haven't moved too far from where it was made.
+*
+***********************************************************************************/
+
+#include "system/visibilityqueryservice.h"
+#include "gamemodes/playgamemode.h"
+
+/**
+* How long a query can go without being made before it's forgotten, in seconds.
+***********************************************************************************/
+
+const float FVisibilityQueryService::ForgetAfter = 5.0f;
+
+/**
+* How far either end point can move from where a result was traced before it's no
+* longer valid, in centimeters. This is enough to cover a frame or so of movement
+* for a fast vehicle, so that asynchronous results are still of use when they arrive.
+***********************************************************************************/
+
+const float FVisibilityQueryService::EndpointTolerance = 500.0f;
+
+/**
+* Can a target be seen from a source?
+***********************************************************************************/
+
+bool FVisibilityQueryService::IsVisible(const void* source, const void* target, const FVector& from, const FVector& to, ECollisionChannel channel, const FCollisionQueryParams& params, float validFor, EVisibilityQueryFallback fallback)
+{
+	check(IsInGameThread());
+	check(World != nullptr);
+
+	float time = World->GetTimeSeconds();
+	FVisibilityQuery& query = Queries.FindOrAdd(FVisibilityQueryKey(source, target, params.TraceTag));
+
+	query.RequestTime = time;
+
+	FrameStats.Queries++;
+
+	CollectResult(query, time);
+
+	if (query.HasResult == true &&
+		time - query.ResultTime <= validFor &&
+		EndpointsMatch(query.From, query.To, from, to) == true)
+	{
+		FrameStats.CacheHits++;
+
+		// Refresh the result before it expires, or before the end points move too far
+		// from where it was traced, so that there's normally always a valid result.
+
+		if (time - query.ResultTime > validFor * 0.5f ||
+			EndpointsMatch(query.From, query.To, from, to, 0.5f) == false)
+		{
+			IssueAsyncTrace(query, from, to, channel, params);
+		}
+
+		return query.Visible;
+	}
+
+	// There's no valid result for these end points, so never return the last one.
+
+	if (fallback == EVisibilityQueryFallback::Synchronous)
+	{
+		// The caller can't wait, so trace now.
+
+		FrameStats.SyncTraces++;
+
+		query.Visible = (World->LineTraceTestByChannel(from, to, channel, params) == false);
+		query.From = from;
+		query.To = to;
+		query.ResultTime = time;
+		query.HasResult = true;
+
+		return query.Visible;
+	}
+
+	// Issue an asynchronous trace to get a result, which will be available on the
+	// next frame.
+
+	IssueAsyncTrace(query, from, to, channel, params);
+
+	return (fallback == EVisibilityQueryFallback::AssumeVisible);
+}
+
+/**
+* Issue an asynchronous trace for a query, unless a similar one is already in
+* flight.
+***********************************************************************************/
+
+void FVisibilityQueryService::IssueAsyncTrace(FVisibilityQuery& query, const FVector& from, const FVector& to, ECollisionChannel channel, const FCollisionQueryParams& params)
+{
+	if (query.Handle.IsValid() == false ||
+		EndpointsMatch(query.TraceFrom, query.TraceTo, from, to, 0.5f) == false)
+	{
+		// Any trace already in flight is simply abandoned here, and will expire without
+		// its result being collected.
+
+		FrameStats.AsyncTraces++;
+
+		query.Handle = World->AsyncLineTraceByChannel(EAsyncTraceType::Single, from, to, channel, params);
+		query.TraceFrom = from;
+		query.TraceTo = to;
+	}
+}
+
+/**
+* Collect the result of any asynchronous trace in flight for a query.
+***********************************************************************************/
+
+void FVisibilityQueryService::CollectResult(FVisibilityQuery& query, float time)
+{
+	if (query.Handle.IsValid() == true)
+	{
+		FTraceDatum data;
+
+		if (World->QueryTraceData(query.Handle, data) == true)
+		{
+			query.Visible = (data.OutHits.Num() == 0 || data.OutHits[0].bBlockingHit == false);
+			query.From = query.TraceFrom;
+			query.To = query.TraceTo;
+			query.ResultTime = time;
+			query.HasResult = true;
+			query.Handle = FTraceHandle();
+		}
+		else if (World->IsTraceHandleValid(query.Handle, false) == false)
+		{
+			// The trace has expired without its result being collected.
+
+			query.Handle = FTraceHandle();
+		}
+	}
+}
+
+/**
+* Tick the service at the end of a frame, collecting the results of asynchronous
+* traces and forgetting queries that are no longer being made.
+***********************************************************************************/
+
+void FVisibilityQueryService::Tick()
+{
+	if (World == nullptr)
+	{
+		return;
+	}
+
+	float time = World->GetTimeSeconds();
+
+	for (auto itr = Queries.CreateIterator(); itr; ++itr)
+	{
+		if (time - itr.Value().RequestTime > ForgetAfter)
+		{
+			itr.RemoveCurrent();
+		}
+		else
+		{
+			CollectResult(itr.Value(), time);
+		}
+	}
+
+	FrameStats.TrackedPairs = Queries.Num();
+
+	Stats = FrameStats;
+	FrameStats = FVisibilityQueryStats();
+}
+
+/**
+* Can a target be seen from a source? Uses the service of the play game mode if
+* there is one, or a synchronous line trace otherwise.
+***********************************************************************************/
+
+bool FVisibilityQueryService::LineOfSight(const UObject* worldContextObject, const void* source, const void* target, const FVector& from, const FVector& to, ECollisionChannel channel, const FCollisionQueryParams& params, float validFor, EVisibilityQueryFallback fallback)
+{
+	APlayGameMode* gameMode = APlayGameMode::Get(worldContextObject);
+
+	if (gameMode != nullptr)
+	{
+		FVisibilityQueryService& service = gameMode->GetVisibilityQueryService();
+
+		if (service.GetWorld() != gameMode->GetWorld())
+		{
+			service.SetWorld(gameMode->GetWorld());
+		}
+
+		return service.IsVisible(source, target, from, to, channel, params, validFor, fallback);
+	}
+	else
+	{
+		return (worldContextObject->GetWorld()->LineTraceTestByChannel(from, to, channel, params) == false);
+	}
+}
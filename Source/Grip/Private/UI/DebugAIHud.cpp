@@ -70,6 +70,20 @@ void ADebugAIHUD::DrawHUD()
 		AddText(TEXT("Driving Mode"), FText::FromString(GetDrivingMode(Vehicle->GetAI().DrivingMode)));
 		AddInt(TEXT("Mode Distance"), (int32)Vehicle->GetAI().DistanceInDrivingMode());
 
+		if (gameMode != nullptr)
+		{
+			const FAIWorkSchedulerStats& stats = gameMode->GetAIWorkScheduler().GetStats();
+
+			AddInt(TEXT("AI Work Budget (us)"), (int32)stats.BudgetMicroseconds);
+			AddInt(TEXT("AI Work Scheduled (us)"), (int32)stats.ScheduledMicroseconds);
+			AddInt(TEXT("AI Work Spent (us)"), (int32)stats.SpentMicroseconds);
+			AddInt(TEXT("AI Work Granted"), stats.Granted);
+			AddInt(TEXT("AI Work Deferred"), stats.Deferred);
+			AddInt(TEXT("AI Work Forced"), stats.Forced);
+			AddFloat(TEXT("AI Work Max Staleness"), stats.MaxStaleness);
+			AddInt(TEXT("AI Work Overruns"), stats.Overruns);
+		}
+
 #pragma region AIVehicleControl
 
 		AddFloat(TEXT("Steering"), Vehicle->Control.SteeringPosition);
@@ -133,7 +133,7 @@ void ADebugPickupsHUD::DrawHUD()
 
 		AddBool(TEXT("Turbo obstacles"), vehicle->GetAI().TurboObstacles);
 		AddBool(TEXT("IsGrounded"), vehicle->IsGrounded());
-		AddBool(TEXT("IsPracticallyGrounded"), vehicle->IsPracticallyGrounded());
+		AddBool(TEXT("IsPracticallyGrounded"), vehicle->GetFrameSnapshot().PracticallyGrounded);
 		AddFloat(TEXT("GroundedTime"), vehicle->GroundedTime(2.0f));
 		AddFloat(TEXT("GetModeTime"), vehicle->GetModeTime());
 		AddFloat(TEXT("SteeringPosition"), vehicle->GetVehicleControl().SteeringPosition);
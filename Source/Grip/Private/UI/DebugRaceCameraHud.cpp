@@ -170,7 +170,7 @@ void ADebugRaceCameraHUD::DrawHUD()
 			AddBool(TEXT("IsFlipped"), vehicle->IsFlipped());
 			AddBool(TEXT("IsFlippedAndWheelsOnGround"), vehicle->IsFlippedAndWheelsOnGround());
 			AddInt(TEXT("FlipDetection"), vehicle->GetWheels().FlipDetection);
-			AddBool(TEXT("IsAirborne"), vehicle->IsAirborne(false));
+			AddBool(TEXT("IsAirborne"), vehicle->GetFrameSnapshot().Airborne);
 
 #pragma region VehicleSpringArm
 
@@ -37,9 +37,9 @@ void ADebugVehicleHUD::DrawHUD()
 	{
 		AddBool(TEXT("IsFlipped"), vehicle->IsFlipped());
 		AddBool(TEXT("IsFlippedAndWheelsOnGround"), vehicle->IsFlippedAndWheelsOnGround());
-		AddBool(TEXT("IsPracticallyGrounded"), vehicle->IsPracticallyGrounded());
+		AddBool(TEXT("IsPracticallyGrounded"), vehicle->GetFrameSnapshot().PracticallyGrounded);
 		AddFloat(TEXT("ContactData.ModeTime"), vehicle->Physics.ContactData.ModeTime);
-		AddFloat(TEXT("GetSurfaceDistance"), FMath::Max(0.0f, vehicle->GetSurfaceDistance(false) - vehicle->GetMaxWheelRadius()));
+		AddFloat(TEXT("GetSurfaceDistance"), FMath::Max(0.0f, vehicle->GetFrameSnapshot().SurfaceDistance - vehicle->GetMaxWheelRadius()));
 		AddText(TEXT("GetSurfaceName"), FText::FromName(vehicle->GetSurfaceName()));
 		AddFloat(TEXT("GetSpeedKPH"), vehicle->GetSpeedKPH());
 
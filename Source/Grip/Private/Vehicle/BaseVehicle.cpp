@@ -274,10 +274,6 @@ ABaseVehicle::ABaseVehicle()
 		WheelOffsets.Emplace(FVector::ZeroVector);
 		WheelRotations.Emplace(FRotator::ZeroRotator);
 	}
-
-#if GRIP_ENGINE_PHYSICS_MODIFIED
-	OnCalculateCustomPhysics.BindUObject(this, &ABaseVehicle::SubstepPhysics);
-#endif // GRIP_ENGINE_PHYSICS_MODIFIED
 }
 
 #pragma region APawn
@@ -453,6 +449,18 @@ void ABaseVehicle::PostInitializeComponents()
 
 	for (const FWheelAssignment& assignment : WheelAssignments)
 	{
+		if (Wheels.Wheels.Num() == FVehicleWheelsHotData::MaxWheels)
+		{
+			// The packed wheel data has a fixed capacity, so any further wheels are rejected
+			// rather than overrunning it.
+
+			UE_LOG(GripLog, Warning, TEXT("Vehicle %s has more than %d wheels, the rest have been ignored"), *GetName(), FVehicleWheelsHotData::MaxWheels);
+
+			ensureAlwaysMsgf(false, TEXT("Too many wheels on vehicle %s"), *GetName());
+
+			break;
+		}
+
 		FName boneName = assignment.BoneName;
 		int32 boneIndex = VehicleMesh->GetBoneIndex(boneName);
 		EWheelPlacement placement = assignment.Placement;
@@ -591,6 +599,8 @@ void ABaseVehicle::PostInitializeComponents()
 		Wheels.RearAxleOffset /= rearSum;
 	}
 
+	Wheels.HotData.SetNumWheels(Wheels.Wheels.Num());
+
 #pragma endregion VehicleContactSensors
 
 #pragma region VehicleBasicForces
@@ -637,6 +647,18 @@ void ABaseVehicle::PostInitializeComponents()
 
 #pragma endregion VehicleAntiGravity
 
+	// Now we know what type of vehicle this is, bind the physics sub-step that has been
+	// specialized for it.
+
+	if (Antigravity == true)
+	{
+		OnCalculateCustomPhysics.BindUObject(this, &ABaseVehicle::SubstepPhysics<true>);
+	}
+	else
+	{
+		OnCalculateCustomPhysics.BindUObject(this, &ABaseVehicle::SubstepPhysics<false>);
+	}
+
 	AI.OptimumSpeedExtension = FMath::Max(0.0f, (GripCoefficient - 0.5f) * 2.0f);
 
 	if (PlayGameMode != nullptr &&
@@ -803,6 +825,7 @@ void ABaseVehicle::EndPlay(const EEndPlayReason::Type endPlayReason)
 		GRIP_REMOVE_FROM_GAME_MODE_LIST_FROM(Vehicles, PlayGameMode);
 
 		PlayGameMode->RemoveAvoidable(this);
+		PlayGameMode->RemoveContactPolicy(this);
 	}
 
 	Super::EndPlay(endPlayReason);
@@ -1202,7 +1225,7 @@ void ABaseVehicle::UpdatePhysics(float deltaSeconds, const FTransform& transform
 #if GRIP_ENGINE_PHYSICS_MODIFIED
 		PhysicsBody->AddCustomPhysics(OnCalculateCustomPhysics);
 #else // GRIP_ENGINE_PHYSICS_MODIFIED
-		SubstepPhysics(deltaSeconds, PhysicsBody);
+		OnCalculateCustomPhysics.ExecuteIfBound(deltaSeconds, PhysicsBody);
 #endif // GRIP_ENGINE_PHYSICS_MODIFIED
 	}
 
@@ -1219,12 +1242,6 @@ void ABaseVehicle::UpdatePhysics(float deltaSeconds, const FTransform& transform
 
 	if (PlayGameMode != nullptr)
 	{
-		int32 totalVehicles = PlayGameMode->GetVehicles().Num();
-
-		Clock0p5.Tick(VehicleIndex, totalVehicles);
-		Clock0p25.Tick(VehicleIndex, totalVehicles);
-		Clock0p1.Tick(VehicleIndex, totalVehicles);
-
 #pragma region VehicleBasicForces
 
 		if (PlayGameMode->PastGameSequenceStart() == false)
@@ -1412,6 +1429,12 @@ void ABaseVehicle::SetupExtraCollision()
 
 		GRIP_ATTACH(VehicleCollision, VehicleMesh, NAME_None);
 
+		// Track the speed pads and pickups we run over with overlap events rather than
+		// polling for them every frame.
+
+		VehicleCollision->OnComponentBeginOverlap.AddDynamic(this, &ABaseVehicle::OnPadBeginOverlap);
+		VehicleCollision->OnComponentEndOverlap.AddDynamic(this, &ABaseVehicle::OnPadEndOverlap);
+
 		VehicleCollision->RegisterComponent();
 
 #pragma endregion VehicleCollision
@@ -3403,13 +3426,7 @@ void ABaseVehicle::ComputeSurfaceEffectsTimer()
 
 float ABaseVehicle::Noise(float value) const
 {
-	float height = PerlinNoise.Noise1(value * 0.03125f);
-
-	height += PerlinNoise.Noise1(value * 0.0625f) * 0.5f;
-	height += PerlinNoise.Noise1(value * 0.125f) * 0.25f;
-	height += PerlinNoise.Noise1(value * 0.25f) * 0.125f;
-
-	return height + 0.625f;
+	return PerlinNoise.OctaveNoise1(value) + 0.625f;
 }
 
 #pragma endregion VehicleSurfaceEffects
@@ -6179,6 +6196,29 @@ UParticleSystemComponent* ABaseVehicle::SpawnParticleSystem(UParticleSystem* emi
 	return component;
 }
 
+/**
+* Spawn an appropriately scaled, short-lived particle system on the vehicle, taken
+* from the world's particle system pool rather than being created afresh.
+*
+* The component is returned to the pool automatically when it completes, so the
+* caller mustn't hold onto it.
+***********************************************************************************/
+
+UParticleSystemComponent* ABaseVehicle::SpawnPooledParticleSystem(UParticleSystem* emitterTemplate, FName attachPointName, FVector location, FRotator rotation, float scale)
+{
+	if (emitterTemplate == nullptr)
+	{
+		return nullptr;
+	}
+
+	if (scale < KINDA_SMALL_NUMBER)
+	{
+		scale = 1.0f;
+	}
+
+	return UGameplayStatics::SpawnEmitterAttached(emitterTemplate, RootComponent, attachPointName, location, rotation, AttachedEffectsScale * scale, EAttachLocation::KeepRelativeOffset, true, EPSCPoolMethod::AutoRelease);
+}
+
 /**
 * Shakes the user GamePad, according to strength and duration.
 ***********************************************************************************/
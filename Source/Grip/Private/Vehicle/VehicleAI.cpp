@@ -671,8 +671,10 @@ void ABaseVehicle::AIFollowSpline(const FVector& location, const FVector& wasHea
 	{
 		RaceState.LastDistanceAlongMasterRacingSpline = RaceState.DistanceAlongMasterRacingSpline;
 
-		if (Clock0p25.ShouldTickNow() == true)
+		if (ShouldRunAIWork(EAIWorkType::RouteFollowing) == true)
 		{
+			FAIWorkScope workScope(GetAIWorkScheduler(), EAIWorkType::RouteFollowing);
+
 			AI.RouteFollower.DetermineThis(location, movementSize, numIterations, accuracy);
 		}
 		else
@@ -713,7 +715,7 @@ void ABaseVehicle::AIFollowSpline(const FVector& location, const FVector& wasHea
 			}
 		}
 
-		if (Clock0p25.ShouldTickNow() == true &&
+		if (ShouldRunAIWork(EAIWorkType::RouteFollowing) == true &&
 			HasAIDriver() == false)
 		{
 			// Ensure human drivers are linked to the closest splines if at all possible.
@@ -730,11 +732,13 @@ void ABaseVehicle::AIFollowSpline(const FVector& location, const FVector& wasHea
 
 			AIResetSplineFollowing(false);
 		}
-		else if (Clock0p25.ShouldTickNow() == true &&
+		else if (ShouldRunAIWork(EAIWorkType::RouteFollowing) == true &&
 			AI.RouteFollower.SwitchingSpline == false)
 		{
 			// Check the spline is still in range of the vehicle.
 
+			FAIWorkScope workScope(GetAIWorkScheduler(), EAIWorkType::RouteFollowing);
+
 			AICheckSplineValidity(location, 0.25f, false);
 		}
 
@@ -1192,9 +1196,11 @@ void ABaseVehicle::AIUpdateTargetsOfOpportunity(const FVector& location, const F
 		}
 	}
 
-	if (Clock0p1.ShouldTickNow() == true)
+	if (ShouldRunAIWork(EAIWorkType::Opportunities) == true)
 	{
-		// Only do the time-insensitive stuff every 0.1 seconds where delta times don't matter.
+		// Only do the time-insensitive stuff every 0.1 seconds or so where delta times don't matter.
+
+		FAIWorkScope workScope(GetAIWorkScheduler(), EAIWorkType::Opportunities);
 
 		if (IsUsingTurbo() == false &&
 			GRIP_POINTER_VALID(AI.AttractedToActor) == false)
@@ -1205,12 +1211,12 @@ void ABaseVehicle::AIUpdateTargetsOfOpportunity(const FVector& location, const F
 			{
 				float leastAngle = 0.0f;
 
-				for (auto& element : PlayGameMode->Attractables)
+				auto considerAttractable = [&] (const TTrackSpatialIndex<IAttractableInterface>::FEntry& element)
 				{
 
 #pragma region VehiclePickups
 
-					APickup* pickup = Cast<APickup>(element.Key);
+					APickup* pickup = Cast<APickup>(element.Actor);
 
 					if (pickup != nullptr)
 					{
@@ -1218,7 +1224,7 @@ void ABaseVehicle::AIUpdateTargetsOfOpportunity(const FVector& location, const F
 
 						if (ArePickupSlotsFilled() == true)
 						{
-							continue;
+							return;
 						}
 
 						// If we have some linked-spline rule then ensure we meet it.
@@ -1227,35 +1233,54 @@ void ABaseVehicle::AIUpdateTargetsOfOpportunity(const FVector& location, const F
 							AI.RouteFollower.ThisSpline != pickup->NearestPursuitSpline &&
 							AI.RouteFollower.NextSpline != pickup->NearestPursuitSpline)
 						{
-							continue;
+							return;
 						}
 					}
 
 #pragma endregion VehiclePickups
 
-					IAttractableInterface* attractable = element.Value;
+					IAttractableInterface* attractable = element.Interface;
 
-					if (attractable != nullptr)
+					if (attractable->IsAttractionActive() == true &&
+						attractable->IsAttractorAttracting() == false &&
+						attractable->IsAttractorInRange(location, direction, false) == true)
 					{
-						if (attractable->IsAttractionActive() == true &&
-							attractable->IsAttractorAttracting() == false &&
-							attractable->IsAttractorInRange(location, direction, false) == true)
-						{
-							FVector attractableDirection = attractable->GetAttractionLocation() - location;
+						FVector attractableDirection = attractable->GetAttractionLocation() - location;
 
-							attractableDirection.Normalize();
+						attractableDirection.Normalize();
 
-							float angle = FVector::DotProduct(attractableDirection, direction);
+						float angle = FVector::DotProduct(attractableDirection, direction);
 
-							if (leastAngle < FMath::Abs(angle))
-							{
-								leastAngle = FMath::Abs(angle);
+						if (leastAngle < FMath::Abs(angle))
+						{
+							leastAngle = FMath::Abs(angle);
 
-								AI.AttractedTo = attractable;
-								AI.AttractedToActor = element.Key;
-							}
+							AI.AttractedTo = attractable;
+							AI.AttractedToActor = element.Actor;
 						}
 					}
+				};
+
+				const TTrackSpatialIndex<IAttractableInterface>& attractables = PlayGameMode->AttractablesIndex;
+				float lateralOffset = 0.0f;
+
+				if (attractables.IsValid() == true &&
+					attractables.GetLateralOffset(location, RaceState.DistanceAlongMasterRacingSpline, lateralOffset) == true)
+				{
+					// Only look at the attractables within a window along the track around us, rather
+					// than every one of them. Distances along the spline can be longer than the straight
+					// line distances that attraction ranges are measured in, especially around corners,
+					// so allow some slack ahead.
+
+					float range = attractables.GetMaxRange();
+
+					attractables.ForEachInWindow(RaceState.DistanceAlongMasterRacingSpline, range, range * 2.0f, lateralOffset, range * 0.5f, considerAttractable);
+				}
+				else
+				{
+					// Look at all the attractables around the track to see if we should head towards any of them.
+
+					attractables.ForEach(considerAttractable);
 				}
 
 				if (GRIP_POINTER_VALID(AI.AttractedToActor) == true)
@@ -1319,8 +1344,6 @@ bool ABaseVehicle::AIShouldContinueToFollow(const FVector& location, const FVect
 
 	// Can this vehicle see the other vehicle?
 
-	FHitResult hit;
-
 	QueryParams.ClearIgnoredActors();
 	QueryParams.AddIgnoredActor(this);
 	QueryParams.AddIgnoredActor(vehicle);
@@ -1329,7 +1352,7 @@ bool ABaseVehicle::AIShouldContinueToFollow(const FVector& location, const FVect
 
 	FVector fromPosition = AI.VehicleFollower.GetAttractionLocation();
 
-	if (GetWorld()->LineTraceSingleByChannel(hit, location + GetLaunchDirection() * 100.0f, fromPosition + vehicle->GetLaunchDirection() * 100.0f, ABaseGameMode::ECC_LineOfSightTest, QueryParams) == true)
+	if (FVisibilityQueryService::LineOfSight(this, this, vehicle, location + GetLaunchDirection() * 100.0f, fromPosition + vehicle->GetLaunchDirection() * 100.0f, ABaseGameMode::ECC_LineOfSightTest, QueryParams, 0.25f, EVisibilityQueryFallback::AssumeVisible) == false)
 	{
 		AI.VehicleFollower.VehicleHiddenTimer += deltaSeconds;
 	}
@@ -2338,7 +2361,7 @@ float ABaseVehicle::AICalculateRollControlInputs(const FTransform& transform, fl
 		FVector endPoint = AI.LastLocation + Physics.VelocityData.Velocity * rollTargetTimeTest;
 
 		if (AI.RollControlTime != 0.0f &&
-			Clock0p1.ShouldTickNow() == false)
+			ShouldRunAIWork(EAIWorkType::RollControlTrace) == false)
 		{
 			// Don't do a line trace every frame, we can reuse the data from the last line
 			// trace for a few frames at least.
@@ -2362,6 +2385,8 @@ float ABaseVehicle::AICalculateRollControlInputs(const FTransform& transform, fl
 		}
 		else
 		{
+			FAIWorkScope workScope(GetAIWorkScheduler(), EAIWorkType::RollControlTrace);
+
 			FHitResult hit;
 
 			QueryParams.bReturnPhysicalMaterial = true;
@@ -2537,8 +2562,10 @@ bool ABaseVehicle::AITeleportIfStuck()
 	{
 		if (RaceState.RaceTime > 10.0f &&
 			VehicleClock - Teleportation.RecoveredAt > 10.0f &&
-			Clock0p25.ShouldTickNow() == true)
+			ShouldRunAIWork(EAIWorkType::StuckDetection) == true)
 		{
+			FAIWorkScope workScope(GetAIWorkScheduler(), EAIWorkType::StuckDetection);
+
 			bool jammedInTheWorld =
 				// We've not got any real speed.
 				GetSpeedKPH() < 10.0f &&
@@ -2723,16 +2750,14 @@ void ABaseVehicle::AIUpdatePickups(float deltaSeconds)
 
 	if (HasPickup(EPickupType::Shield, false) == true)
 	{
-		GRIP_GAME_MODE_LIST_FOR_FROM(Missiles, missiles, PlayGameMode);
-
-		for (AHomingMissile* missile : missiles)
+		for (const FIncomingThreat& threat : GetIncomingThreats())
 		{
-			if (missile->IsTargeting(this) == true &&
-				missile->IsLikelyToHitTarget() == true)
+			if (threat.Locked == true &&
+				threat.LikelyToHit == true)
 			{
 				IncomingMissile = true;
 
-				incomingMissileClose |= (missile->GetTimeToTarget() < 2.5f);
+				incomingMissileClose |= (threat.TimeToTarget < 2.5f);
 			}
 		}
 	}
@@ -2781,14 +2806,21 @@ void ABaseVehicle::AIUpdatePickups(float deltaSeconds)
 			{
 				// If we're now allowed to use the pickup slot, then see if it's efficacious to do so.
 
-				float efficaciousTimeIncrement = (pickup.EfficacyTimer > 0.0f) ? 0.1f : 0.25f;
-
-				if ((pickup.EfficacyTimer <= 0.0f && Clock0p25.ShouldTickNow() == true) ||
-					(pickup.EfficacyTimer > 0.0f && Clock0p1.ShouldTickNow() == true))
+				if ((pickup.EfficacyTimer <= 0.0f && ShouldRunAIWork(EAIWorkType::PickupEfficacy) == true) ||
+					(pickup.EfficacyTimer > 0.0f && ShouldRunAIWork(EAIWorkType::PickupEfficacyActive) == true))
 				{
+					FAIWorkScope workScope(GetAIWorkScheduler(), (pickup.EfficacyTimer > 0.0f) ? EAIWorkType::PickupEfficacyActive : EAIWorkType::PickupEfficacy);
+
 					AActor* target = nullptr;
 					float efficacy = GetPickupEfficacyWeighting(i, target);
 
+					// The work may have been deferred by the scheduler, so take the time that has
+					// actually passed since the efficacy was last checked rather than its nominal period.
+
+					float efficaciousTimeIncrement = VehicleClock - pickup.EfficacyCheckedAt;
+
+					pickup.EfficacyCheckedAt = VehicleClock;
+
 					// Detect the case where we want to use a pickup because it has a dump-after time.
 
 					useNow = (pickup.DumpAfter != 0.0f && pickup.Timer >= pickup.DumpAfter && pickup.EfficacyTimer == 0.0f && efficacy >= 0.0f);
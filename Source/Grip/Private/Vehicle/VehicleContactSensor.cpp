@@ -272,9 +272,10 @@ void FVehicleContactSensor::CalculateContactPoint(float deltaTime, UWorld* world
 }
 
 /**
-* Do the regular update tick.
+* Do the regular update tick, specialized for wheeled or antigravity vehicles.
 ***********************************************************************************/
 
+template <bool TAntigravity>
 void FVehicleContactSensor::Tick(float deltaTime, UWorld* world, const FTransform& transform, const FVector& startPoint, const FVector& direction, bool updatePhysics, bool estimate, bool calculateIfUpward)
 {
 	if (calculateIfUpward == true ||
@@ -283,7 +284,14 @@ void FVehicleContactSensor::Tick(float deltaTime, UWorld* world, const FTransfor
 
 #pragma region VehicleAntiGravity
 
-		CalculateAntigravity(deltaTime, transform, direction);
+		if (TAntigravity == true)
+		{
+			CalculateAntigravity(deltaTime, transform, direction);
+		}
+		else
+		{
+			TiltDirection = direction;
+		}
 
 #pragma endregion VehicleAntiGravity
 
@@ -314,7 +322,10 @@ void FVehicleContactSensor::Tick(float deltaTime, UWorld* world, const FTransfor
 
 #pragma region VehicleAntiGravity
 
-		SetUnifiedAntigravityNormalizedCompression(GetAntigravityNormalizedCompression());
+		if (TAntigravity == true)
+		{
+			SetUnifiedAntigravityNormalizedCompression(GetAntigravityNormalizedCompression());
+		}
 
 #pragma endregion VehicleAntiGravity
 
@@ -322,6 +333,9 @@ void FVehicleContactSensor::Tick(float deltaTime, UWorld* world, const FTransfor
 	}
 }
 
+template void FVehicleContactSensor::Tick<false>(float deltaTime, UWorld* world, const FTransform& transform, const FVector& startPoint, const FVector& direction, bool updatePhysics, bool estimate, bool calculateIfUpward);
+template void FVehicleContactSensor::Tick<true>(float deltaTime, UWorld* world, const FTransform& transform, const FVector& startPoint, const FVector& direction, bool updatePhysics, bool estimate, bool calculateIfUpward);
+
 /**
 * Apply the suspension spring force to the vehicle.
 ***********************************************************************************/
@@ -14,6 +14,11 @@
 * been modified to deal with sub-stepping correctly, or to 0 if using a stock
 * Unreal Engine version.
 *
+* Define GRIP_VEHICLE_FORCE_ACCUMULATION as 1 to have the forces applied during a
+* physics sub-step summed locally, along with the torques they induce around the
+* center of mass, and then applied to the physics body as a single force and
+* torque at the end of the sub-step.
+*
 ***********************************************************************************/
 
 #include "Vehicle/VehicleMeshComponent.h"
@@ -174,6 +179,22 @@ FVector UVehicleMeshComponent::GetPhysicsInertiaTensor() const
 	return result;
 }
 
+/**
+* Get the physics center of mass of the vehicle in world space.
+***********************************************************************************/
+
+FVector UVehicleMeshComponent::GetPhysicsCenterOfMass() const
+{
+	FVector result = FVector::ZeroVector;
+
+	FPhysicsCommand::ExecuteRead(ActorHandle, [&] (const FPhysicsActorHandle& actor)
+		{
+			result = FPhysicsInterface::GetComTransform_AssumesLocked(actor).GetLocation();
+		});
+
+	return result;
+}
+
 /**
 * Set the physics location and quaternion of the vehicle.
 ***********************************************************************************/
@@ -270,6 +291,12 @@ void UVehicleMeshComponent::AddForceSubstep(FVector force, const FName& boneName
 #if GRIP_ENGINE_PHYSICS_MODIFIED
 	if (IsIdleLocked() == false)
 	{
+		if (accelerationChange == false &&
+			AccumulateForce(force) == true)
+		{
+			return;
+		}
+
 		FPhysicsCommand::ExecuteWrite(ActorHandle, [&] (const FPhysicsActorHandle& actor)
 			{
 				if (accelerationChange == true)
@@ -300,6 +327,11 @@ void UVehicleMeshComponent::AddForceAtLocationSubstep(const FVector& force, cons
 #if GRIP_ENGINE_PHYSICS_MODIFIED
 	if (IsIdleLocked() == false)
 	{
+		if (AccumulateForceAtLocation(force, location) == true)
+		{
+			return;
+		}
+
 		FPhysicsCommand::ExecuteWrite(ActorHandle, [&] (const FPhysicsActorHandle& actor)
 			{
 				FPhysicsInterface::AddForceAtLocation_AssumesLocked(actor, force, location);
@@ -320,7 +352,7 @@ void UVehicleMeshComponent::AddForceAtLocationLocalSubstep(const FVector& force,
 	check(location.ContainsNaN() == false);
 
 #if GRIP_ENGINE_PHYSICS_MODIFIED
-	AddForceAtLocation(force, GetPhysicsTransform().TransformPosition(location), boneName);
+	AddForceAtLocationSubstep(force, GetPhysicsTransform().TransformPosition(location), boneName);
 #else // GRIP_ENGINE_PHYSICS_MODIFIED
 	AddForceAtLocationLocal(force, location, boneName);
 #endif // GRIP_ENGINE_PHYSICS_MODIFIED
@@ -441,4 +473,125 @@ void UVehicleMeshComponent::AddAngularImpulseInRadiansSubstep(FVector angularImp
 #endif // GRIP_ENGINE_PHYSICS_MODIFIED
 }
 
+/**
+* Begin accumulating the forces applied during a physics sub-step.
+***********************************************************************************/
+
+void UVehicleMeshComponent::BeginForceAccumulation()
+{
+#if GRIP_ENGINE_PHYSICS_MODIFIED && GRIP_VEHICLE_FORCE_ACCUMULATION
+	check(AccumulatingForces == false);
+
+	AccumulatingForces = true;
+	AccumulatedForce = FVector::ZeroVector;
+	AccumulatedTorque = FVector::ZeroVector;
+	DebugAppliedForce = FVector::ZeroVector;
+	DebugAppliedTorque = FVector::ZeroVector;
+
+	// The pose of the physics body doesn't change during the sub-step so we can
+	// take its center of mass once here and use it for all of the torques.
+
+	AccumulationCenterOfMass = GetPhysicsCenterOfMass();
+#endif // GRIP_ENGINE_PHYSICS_MODIFIED && GRIP_VEHICLE_FORCE_ACCUMULATION
+}
+
+/**
+* End accumulating the forces applied during a physics sub-step, applying them to
+* the physics body.
+***********************************************************************************/
+
+void UVehicleMeshComponent::EndForceAccumulation()
+{
+#if GRIP_ENGINE_PHYSICS_MODIFIED && GRIP_VEHICLE_FORCE_ACCUMULATION
+	if (AccumulatingForces == false)
+	{
+		return;
+	}
+
+	AccumulatingForces = false;
+
+#if GRIP_DEBUG_VEHICLE_FORCE_ACCUMULATION
+	// The forces have already been applied individually, so just check that the
+	// accumulation would have had the same result.
+
+	float forceTolerance = FMath::Max(1.0f, DebugAppliedForce.Size() * 0.0001f);
+	float torqueTolerance = FMath::Max(1.0f, DebugAppliedTorque.Size() * 0.0001f);
+
+	ensureMsgf(AccumulatedForce.Equals(DebugAppliedForce, forceTolerance) == true, TEXT("Accumulated force %s doesn't match applied force %s"), *AccumulatedForce.ToString(), *DebugAppliedForce.ToString());
+	ensureMsgf(AccumulatedTorque.Equals(DebugAppliedTorque, torqueTolerance) == true, TEXT("Accumulated torque %s doesn't match applied torque %s"), *AccumulatedTorque.ToString(), *DebugAppliedTorque.ToString());
+#else // GRIP_DEBUG_VEHICLE_FORCE_ACCUMULATION
+	// Forces are only ever accumulated when the vehicle isn't idle-locked, and it can't
+	// become idle-locked again during the sub-step, so there's no need to check that here.
+
+	if (AccumulatedForce.IsZero() == false ||
+		AccumulatedTorque.IsZero() == false)
+	{
+		FPhysicsCommand::ExecuteWrite(ActorHandle, [&] (const FPhysicsActorHandle& actor)
+			{
+				FPhysicsInterface::AddForce_AssumesLocked(actor, AccumulatedForce);
+				FPhysicsInterface::AddTorque_AssumesLocked(actor, AccumulatedTorque);
+			});
+	}
+#endif // GRIP_DEBUG_VEHICLE_FORCE_ACCUMULATION
+#endif // GRIP_ENGINE_PHYSICS_MODIFIED && GRIP_VEHICLE_FORCE_ACCUMULATION
+}
+
+/**
+* Accumulate a force for the current physics sub-step, returning true if it was
+* accumulated.
+***********************************************************************************/
+
+bool UVehicleMeshComponent::AccumulateForce(const FVector& force)
+{
+	if (AccumulatingForces == false)
+	{
+		return false;
+	}
+
+	AccumulatedForce += force;
+
+#if GRIP_DEBUG_VEHICLE_FORCE_ACCUMULATION
+	// Have the force applied individually too, so we can check the results match.
+
+	DebugAppliedForce += force;
+
+	return false;
+#else // GRIP_DEBUG_VEHICLE_FORCE_ACCUMULATION
+	return true;
+#endif // GRIP_DEBUG_VEHICLE_FORCE_ACCUMULATION
+}
+
+/**
+* Accumulate a force at a location in world space for the current physics sub-step,
+* returning true if it was accumulated.
+***********************************************************************************/
+
+bool UVehicleMeshComponent::AccumulateForceAtLocation(const FVector& force, const FVector& location)
+{
+	if (AccumulatingForces == false)
+	{
+		return false;
+	}
+
+	// This is the same torque that the physics engine computes when applying a force
+	// at a location, it's just that we only hand it over once.
+
+	AccumulatedForce += force;
+	AccumulatedTorque += FVector::CrossProduct(location - AccumulationCenterOfMass, force);
+
+#if GRIP_DEBUG_VEHICLE_FORCE_ACCUMULATION
+	// Have the force applied individually too, so we can check the results match.
+	// Use the live center of mass here rather than the one we took at the start.
+
+	FVector centerOfMass = GetPhysicsCenterOfMass();
+
+	DebugAppliedForce += force;
+	DebugAppliedTorque += FVector::CrossProduct(location - centerOfMass, force);
+
+	return false;
+#else // GRIP_DEBUG_VEHICLE_FORCE_ACCUMULATION
+	return true;
+#endif // GRIP_DEBUG_VEHICLE_FORCE_ACCUMULATION
+}
+
 #pragma endregion Vehicle
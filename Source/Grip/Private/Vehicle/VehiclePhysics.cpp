@@ -18,12 +18,21 @@
 #include "vehicle/flippablevehicle.h"
 #include "effects/drivingsurfacecharacteristics.h"
 #include "pickups/shield.h"
+#include "system/gridbenchmark.h"
 
 #if WITH_PHYSX
 #include "pxcontactmodifycallback.h"
 #include "runtime/engine/private/physicsengine/physxsupport.h"
 #endif // WITH_PHYSX
 
+DECLARE_STATS_GROUP(TEXT("GRIP Vehicle Physics"), STATGROUP_GripVehiclePhysics, STATCAT_Advanced);
+DECLARE_CYCLE_STAT(TEXT("Substep Physics (Wheeled)"), STAT_SubstepPhysicsWheeled, STATGROUP_GripVehiclePhysics);
+DECLARE_CYCLE_STAT(TEXT("Substep Physics (Antigravity)"), STAT_SubstepPhysicsAntigravity, STATGROUP_GripVehiclePhysics);
+DECLARE_CYCLE_STAT(TEXT("Substep Physics (4 Wheels)"), STAT_SubstepPhysicsFourWheels, STATGROUP_GripVehiclePhysics);
+DECLARE_CYCLE_STAT(TEXT("Substep Physics (6 Wheels)"), STAT_SubstepPhysicsSixWheels, STATGROUP_GripVehiclePhysics);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Contact Sets Modified"), STAT_ContactSetsModified, STATGROUP_GripVehiclePhysics);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Vehicle Contact Sets Modified"), STAT_VehicleContactSetsModified, STATGROUP_GripVehiclePhysics);
+
 /**
 * Do the regular physics update tick, for every sub-step.
 *
@@ -40,10 +49,22 @@
 * As the regular vehicle actor Tick is run PostPhysics you can do any cleanup work
 * at the beginning of that Tick function, knowing that you'll be reading the most
 * up-to-date information from the physics system.
+*
+* This is specialized at compile time for wheeled and antigravity vehicles, the
+* specialization being bound to OnCalculateCustomPhysics when the vehicle is setup,
+* so that the vehicle type isn't tested over and over in the inner loops.
 ***********************************************************************************/
 
+template <bool TAntigravity>
 void ABaseVehicle::SubstepPhysics(float deltaSeconds, FBodyInstance* bodyInstance)
 {
+	CONDITIONAL_SCOPE_CYCLE_COUNTER(STAT_SubstepPhysicsWheeled, TAntigravity == false);
+	CONDITIONAL_SCOPE_CYCLE_COUNTER(STAT_SubstepPhysicsAntigravity, TAntigravity == true);
+	CONDITIONAL_SCOPE_CYCLE_COUNTER(STAT_SubstepPhysicsFourWheels, Wheels.Wheels.Num() == 4);
+	CONDITIONAL_SCOPE_CYCLE_COUNTER(STAT_SubstepPhysicsSixWheels, Wheels.Wheels.Num() == 6);
+
+	FGridBenchmark::FScopedPhysicsTimer benchmarkTimer;
+
 	if (World == nullptr)
 	{
 		return;
@@ -105,6 +126,11 @@ void ABaseVehicle::SubstepPhysics(float deltaSeconds, FBodyInstance* bodyInstanc
 
 #pragma endregion VehicleAntiGravity
 
+	// Sum all of the forces that we apply from here on in and hand them over to the
+	// physics body in one go at the end of the sub-step.
+
+	VehicleMesh->BeginForceAccumulation();
+
 	// Grab a few things directly from the physics body and keep them in local variables,
 	// sharing them around the update where appropriate.
 
@@ -188,7 +214,7 @@ void ABaseVehicle::SubstepPhysics(float deltaSeconds, FBodyInstance* bodyInstanc
 
 #pragma region VehicleAntiGravity
 
-	if (Antigravity == true)
+	if (TAntigravity == true)
 	{
 		// Perform some extended smoothing on the steering position for antigravity vehicle
 		// as it they react too sharply they just feel wrong.
@@ -221,7 +247,7 @@ void ABaseVehicle::SubstepPhysics(float deltaSeconds, FBodyInstance* bodyInstanc
 	// This is the core processing of contact sensors and most the work required for
 	// them resides in UpdateContactSensors.
 
-	Wheels.NumWheelsInContact = UpdateContactSensors(deltaSeconds, transform, xdirection, ydirection, zdirection);
+	Wheels.NumWheelsInContact = UpdateContactSensors<TAntigravity>(deltaSeconds, transform, xdirection, ydirection, zdirection);
 	Wheels.FrontAxlePosition = transform.TransformPosition(FVector(Wheels.FrontAxleOffset, 0.0f, 0.0f));
 	Wheels.RearAxlePosition = transform.TransformPosition(FVector(Wheels.RearAxleOffset, 0.0f, 0.0f));
 
@@ -427,15 +453,28 @@ void ABaseVehicle::SubstepPhysics(float deltaSeconds, FBodyInstance* bodyInstanc
 
 	// Determine the location in world space of all the wheels, along with their velocity.
 
-	for (FVehicleWheel& wheel : Wheels.Wheels)
+	for (int32 wheelIndex = 0; wheelIndex < Wheels.Wheels.Num(); wheelIndex++)
 	{
+		FVehicleWheel& wheel = Wheels.Wheels[wheelIndex];
+
 		// We grab the standard wheel location here, which keeps the application of grip
 		// consistent across different vehicles, so that we can tune it more easily when
 		// we want it to be different for each vehicle model.
 
 		wheel.Location = GetStandardWheelLocation(wheel, transform);
-		wheel.Velocity = VehicleMesh->GetPhysicsLinearVelocityAtPoint(wheel.Location);
 		wheel.LateralForceVector = FVector::ZeroVector;
+
+		Wheels.HotData.SetLocation(wheelIndex, wheel.Location);
+	}
+
+	// Calculate the velocities for all of the wheels in one go from the rigid body state
+	// rather than asking the physics system for each one individually.
+
+	Wheels.HotData.CalculateVelocities(VehicleMesh->GetPhysicsLinearVelocity(), VehicleMesh->GetPhysicsAngularVelocityInRadians(), VehicleMesh->GetPhysicsCenterOfMass(), zdirection);
+
+	for (int32 wheelIndex = 0; wheelIndex < Wheels.Wheels.Num(); wheelIndex++)
+	{
+		Wheels.Wheels[wheelIndex].Velocity = Wheels.HotData.GetVelocity(wheelIndex);
 	}
 
 #pragma endregion VehicleBasicForces
@@ -523,7 +562,7 @@ void ABaseVehicle::SubstepPhysics(float deltaSeconds, FBodyInstance* bodyInstanc
 	float forwardRatio = 1.0f;
 	float scaleAntigravity = 1.0f;
 
-	if (Antigravity == true)
+	if (TAntigravity == true)
 	{
 		// scaleAntigravity simply means less grip the more sideways we're moving as we want to have
 		// great grip when traveling forwards but not have the vehicle solid on the ground when collided
@@ -543,11 +582,12 @@ void ABaseVehicle::SubstepPhysics(float deltaSeconds, FBodyInstance* bodyInstanc
 
 	float stablisingGripVsSpeed = TireFrictionModel->RearLateralGripVsSpeed.GetRichCurve()->Eval(GetSpeedKPH());
 
-	for (FVehicleWheel& wheel : Wheels.Wheels)
+	for (int32 wheelIndex = 0; wheelIndex < Wheels.Wheels.Num(); wheelIndex++)
 	{
+		FVehicleWheel& wheel = Wheels.Wheels[wheelIndex];
 		float surfaceFriction = 1.0f;
 		FVector wheelForce = FVector::ZeroVector;
-		FQuat wheelQuaternion = wheel.GetSteeringTransform(transformQuaternion, Antigravity);
+		FQuat wheelQuaternion = wheel.GetSteeringTransform(transformQuaternion, TAntigravity);
 
 		if (DrivingSurfaceCharacteristics != nullptr)
 		{
@@ -571,7 +611,7 @@ void ABaseVehicle::SubstepPhysics(float deltaSeconds, FBodyInstance* bodyInstanc
 #if GRIP_NORMALIZED_WEIGHT_ON_WHEEL
 			float weightOnWheel = averageWeight;
 
-			if (Antigravity == false)
+			if (TAntigravity == false)
 			{
 				// Dirty hack to stop people whining about loss of control. This ensures
 				// that we have symmetrical grip for each wheel on a particular axle at
@@ -636,7 +676,7 @@ void ABaseVehicle::SubstepPhysics(float deltaSeconds, FBodyInstance* bodyInstanc
 
 #if GRIP_NORMALIZE_GRIP_ON_LANDING
 
-			if (Antigravity == false)
+			if (TAntigravity == false)
 			{
 				// No need to centralize grip on antigravity vehicles as all springs will share the same
 				// value with regard to grip ratio.
@@ -716,7 +756,7 @@ void ABaseVehicle::SubstepPhysics(float deltaSeconds, FBodyInstance* bodyInstanc
 
 			float lateralSlip = 0.0f;
 			FVector lateralAxis = wyNormalized;
-			FVector wvNormalized = GetHorizontalVelocity(wheel, transform);
+			FVector wvNormalized = Wheels.HotData.GetHorizontalVelocity(wheelIndex);
 
 #pragma region VehicleDrifting
 
@@ -741,7 +781,7 @@ void ABaseVehicle::SubstepPhysics(float deltaSeconds, FBodyInstance* bodyInstanc
 			{
 				// Invert the lateral friction as we want to oppose the side-slip force.
 
-				lateralForce = -LateralFriction(lateralGripScale, lateralSlip, wheel) * scaleAntigravity;
+				lateralForce = -LateralFriction(lateralGripScale, lateralSlip, Wheels.HotData.GetSpeed(wheelIndex)) * scaleAntigravity;
 
 #pragma region VehicleDrifting
 
@@ -774,7 +814,7 @@ void ABaseVehicle::SubstepPhysics(float deltaSeconds, FBodyInstance* bodyInstanc
 
 #pragma region VehicleAntiGravity
 
-				if (Antigravity == true &&
+				if (TAntigravity == true &&
 					forwardRatio < 1.0f - KINDA_SMALL_NUMBER &&
 					FMath::Abs(steeringPosition) > KINDA_SMALL_NUMBER)
 				{
@@ -991,7 +1031,7 @@ void ABaseVehicle::SubstepPhysics(float deltaSeconds, FBodyInstance* bodyInstanc
 
 #pragma region VehicleAntiGravity
 
-				if (Antigravity == true &&
+				if (TAntigravity == true &&
 					RaceState.RaceTime > 2.0f)
 				{
 					// Lose grip when we've lost power, but not on the start line.
@@ -1461,16 +1501,22 @@ void ABaseVehicle::SubstepPhysics(float deltaSeconds, FBodyInstance* bodyInstanc
 
 	Physics.Timing.LastSubstepDeltaSeconds = deltaSeconds;
 
+	VehicleMesh->EndForceAccumulation();
+
 #pragma endregion VehicleBasicForces
 
 }
 
+template void ABaseVehicle::SubstepPhysics<false>(float deltaSeconds, FBodyInstance* bodyInstance);
+template void ABaseVehicle::SubstepPhysics<true>(float deltaSeconds, FBodyInstance* bodyInstance);
+
 #pragma region VehicleContactSensors
 
 /**
 * Update the contact sensors.
 ***********************************************************************************/
 
+template <bool TAntigravity>
 int32 ABaseVehicle::UpdateContactSensors(float deltaSeconds, const FTransform& transform, const FVector& xdirection, const FVector& ydirection, const FVector& zdirection)
 {
 	static FName noSurface("None");
@@ -1530,7 +1576,7 @@ int32 ABaseVehicle::UpdateContactSensors(float deltaSeconds, const FTransform& t
 				FVehicleContactSensor& sensor = wheel.Sensors[Wheels.GroundedSensorSet];
 				FVector springTop = GetWheelBoneLocation(wheel, transform, true);
 
-				sensor.Tick(deltaSeconds, World, transform, springTop, zdirection, true, estimate == true && SHOULD_ESTIMATE, IsFlippable());
+				sensor.Tick<TAntigravity>(deltaSeconds, World, transform, springTop, zdirection, true, estimate == true && SHOULD_ESTIMATE, IsFlippable());
 
 				allInContact &= sensor.IsInContact();
 			}
@@ -1542,7 +1588,7 @@ int32 ABaseVehicle::UpdateContactSensors(float deltaSeconds, const FTransform& t
 				FVehicleContactSensor& sensor = wheel.Sensors[Wheels.GroundedSensorSet ^ 1];
 				FVector springTop = GetWheelBoneLocation(wheel, transform, true);
 
-				sensor.Tick(deltaSeconds, World, transform, springTop, zdirection, (allInContact == false), estimate == true && SHOULD_ESTIMATE, IsFlippable());
+				sensor.Tick<TAntigravity>(deltaSeconds, World, transform, springTop, zdirection, (allInContact == false), estimate == true && SHOULD_ESTIMATE, IsFlippable());
 			}
 		}
 		else
@@ -1557,7 +1603,7 @@ int32 ABaseVehicle::UpdateContactSensors(float deltaSeconds, const FTransform& t
 				{
 					FVector springTop = GetWheelBoneLocation(wheel, transform, true);
 
-					sensor.Tick(deltaSeconds, World, transform, springTop, zdirection, true, estimate == true && SHOULD_ESTIMATE, IsFlippable());
+					sensor.Tick<TAntigravity>(deltaSeconds, World, transform, springTop, zdirection, true, estimate == true && SHOULD_ESTIMATE, IsFlippable());
 				}
 			}
 		}
@@ -1679,7 +1725,7 @@ int32 ABaseVehicle::UpdateContactSensors(float deltaSeconds, const FTransform& t
 				}
 			}
 
-			if (Antigravity == false)
+			if (TAntigravity == false)
 			{
 				// Scale the suspension forces.
 
@@ -1810,7 +1856,7 @@ int32 ABaseVehicle::UpdateContactSensors(float deltaSeconds, const FTransform& t
 		}
 
 #if GRIP_VEHICLE_SUSPENSION_BOUNCE_NORMALIZE
-		if (Antigravity == false &&
+		if (TAntigravity == false &&
 			Physics.SpringScaleTimer != 0.0f &&
 			Physics.ContactData.Grounded == true)
 		{
@@ -1846,7 +1892,7 @@ int32 ABaseVehicle::UpdateContactSensors(float deltaSeconds, const FTransform& t
 
 #pragma region VehicleAntiGravity
 
-		else if (Antigravity == true)
+		else if (TAntigravity == true)
 		{
 			// Try to balance the forces when not in contact so that we don't get the back-end
 			// pushing you over if the front-end has no contact, like coming off a ramp for example.
@@ -2068,7 +2114,7 @@ int32 ABaseVehicle::UpdateContactSensors(float deltaSeconds, const FTransform& t
 
 #pragma region VehicleAntiGravity
 
-			if (Antigravity == true)
+			if (TAntigravity == true)
 			{
 				minAntigravityCompression = FMath::Min(minAntigravityCompression, wheel.GetActiveSensor().GetAntigravityNormalizedCompression());
 
@@ -2102,7 +2148,7 @@ int32 ABaseVehicle::UpdateContactSensors(float deltaSeconds, const FTransform& t
 
 #pragma region VehicleAntiGravity
 
-			if (Antigravity == true)
+			if (TAntigravity == true)
 			{
 				wheel.GetActiveSensor().SetUnifiedAntigravityNormalizedCompression(minAntigravityCompression);
 			}
@@ -2141,7 +2187,7 @@ int32 ABaseVehicle::UpdateContactSensors(float deltaSeconds, const FTransform& t
 
 #pragma region VehicleAntiGravity
 
-			if (Antigravity == true)
+			if (TAntigravity == true)
 			{
 				// Calculate the outboard offset for the contact sensor, allowing it to adjust
 				// its tilt direction towards the outboard direction in order to transition the
@@ -2197,7 +2243,7 @@ int32 ABaseVehicle::UpdateContactSensors(float deltaSeconds, const FTransform& t
 #pragma region VehicleAntiGravity
 
 		if (blocked == true &&
-			Antigravity == true)
+			TAntigravity == true)
 		{
 			// If we're blocked on this wheel then kill the tilt scale.
 
@@ -2292,7 +2338,7 @@ int32 ABaseVehicle::UpdateContactSensors(float deltaSeconds, const FTransform& t
 
 #pragma region VehicleAntiGravity
 
-				if (Antigravity == true)
+				if (TAntigravity == true)
 				{
 					scale = scale * 0.25f + 0.5f;
 				}
@@ -2308,7 +2354,7 @@ int32 ABaseVehicle::UpdateContactSensors(float deltaSeconds, const FTransform& t
 
 #pragma region NavigationSplines
 
-				if (Antigravity == false)
+				if (TAntigravity == false)
 				{
 					if (AI.RouteFollower.ThisSpline != nullptr &&
 						AI.RouteFollower.NextSpline != nullptr)
@@ -2374,7 +2420,7 @@ int32 ABaseVehicle::UpdateContactSensors(float deltaSeconds, const FTransform& t
 
 #pragma region VehicleAntiGravity
 
-		if (Antigravity == true)
+		if (TAntigravity == true)
 		{
 			Physics.Bounce.Timer -= deltaSeconds * 8.0f;
 		}
@@ -2718,6 +2764,33 @@ FVector ABaseVehicle::GetPredictedVelocity() const
 	return direction * velocity.Size();
 }
 
+/**
+* Take the frame snapshot of the vehicle and publish it to the game mode.
+*
+* The contact sensors and velocity data that these queries are based on only
+* change during physics, so everything else querying them during the frame can
+* read this snapshot rather than recomputing them each time. This is only called
+* by the game mode, for all of the vehicles together at the end of the frame.
+***********************************************************************************/
+
+void ABaseVehicle::UpdateFrameSnapshot()
+{
+	FVehicleFrameSnapshot snapshot;
+
+	snapshot.PredictedVelocity = GetPredictedVelocity();
+	snapshot.SurfaceDirection = GetSurfaceDirection();
+	snapshot.SurfaceNormal = GetSurfaceNormal();
+	snapshot.GuessedSurfaceNormal = GuessSurfaceNormal();
+	snapshot.SpeedKPH = GetSpeedKPH();
+	snapshot.SurfaceDistance = GetSurfaceDistance(false);
+	snapshot.FrameNumber = (uint32)GFrameCounter;
+	snapshot.Airborne = IsAirborne();
+	snapshot.AirborneIgnoringSkipping = IsAirborne(true);
+	snapshot.PracticallyGrounded = IsPracticallyGrounded();
+
+	PlayGameMode->SetVehicleSnapshot(VehicleIndex, snapshot);
+}
+
 #pragma endregion VehicleBasicForces
 
 #pragma region VehicleGrip
@@ -2833,13 +2906,11 @@ void ABaseVehicle::CalculateWheelRotationRate(FVehicleWheel& wheel, const FVecto
 * velocity vs the wheel side vector. More side-slip should mean more lateral force.
 ***********************************************************************************/
 
-float ABaseVehicle::LateralFriction(float baselineFriction, float sideSlip, FVehicleWheel& wheel) const
+float ABaseVehicle::LateralFriction(float baselineFriction, float sideSlip, float speed) const
 {
 	// sideSlip is the cosine of the angle of the normalized wheel velocity vs the wheel side
-	// vector. so 0 means no side-slip and +-1 means full side slip. velocity is the wheel's
-	// velocity in meters per second.
-
-	float speed = wheel.Velocity.Size();
+	// vector. so 0 means no side-slip and +-1 means full side slip. speed is the wheel's
+	// speed in centimeters per second.
 
 	// Generally grip should be constant, but we add more at very speeds to avoid sliding around.
 	// (about 50% more)
@@ -3178,12 +3249,36 @@ bool ABaseVehicle::ModifyContact(uint32 bodyIndex, AActor* other, physx::PxConta
 
 	VehicleMesh->IdleUnlock();
 
+	INC_DWORD_STAT(STAT_ContactSetsModified);
+
 	if (other != nullptr)
 	{
-		ABaseVehicle* otherVehicle = Cast<ABaseVehicle>(other);
+		// Use the contact policy registered with the game mode to identify the other
+		// actor, rather than casting it for every contact set. Contacts with anything
+		// other than a vehicle are left alone, so we can get out early for those.
+
+		ABaseVehicle* otherVehicle = nullptr;
+
+		if (PlayGameMode != nullptr)
+		{
+			FActorContactPolicy policy = PlayGameMode->GetContactPolicy(other);
+
+			if (policy.Policy != EActorContactPolicy::Vehicle)
+			{
+				return false;
+			}
+
+			otherVehicle = policy.Vehicle;
+		}
+		else
+		{
+			otherVehicle = Cast<ABaseVehicle>(other);
+		}
 
 		if (otherVehicle != nullptr)
 		{
+			INC_DWORD_STAT(STAT_VehicleContactSetsModified);
+
 			// Unlock the idle state for the opposing vehicle.
 
 			otherVehicle->VehicleMesh->IdleUnlock();
@@ -188,38 +188,34 @@ bool FPlayerPickupSlot::IsCharging(bool confirmed) const
 
 void ABaseVehicle::CollectSpeedPads()
 {
-	if (GRIP_OBJECT_VALID(VehicleCollision) == true)
+	if (OverlappingSpeedPads.Num() > 0)
 	{
-		// Determine which speed pad actors are currently overlapping with this
-		// vehicle's collision shell.
+		// If we have any overlapping speed pads then find the closest one to the vehicle.
 
-		TSet<AActor*> collectedActors;
+		float minDistance = 0.0f;
+		ASpeedPad* closestSpeedpad = nullptr;
+		FVector location = GetActorLocation();
 
-		VehicleCollision->GetOverlappingActors(collectedActors, ASpeedPad::StaticClass());
-
-		if (collectedActors.Num() > 0)
+		for (const TWeakObjectPtr<ASpeedPad>& speedpad : OverlappingSpeedPads)
 		{
-			// If we have any overlapping speed pads then find the closest one to the vehicle.
-
-			float minDistance = 0.0f;
-			AActor* closestSpeedpad = nullptr;
-			FVector location = GetActorLocation();
-
-			for (AActor* actor : collectedActors)
+			if (GRIP_POINTER_VALID(speedpad) == true)
 			{
-				float distance = (actor->GetActorLocation() - location).SizeSquared();
+				float distance = (speedpad->GetActorLocation() - location).SizeSquared();
 
 				if (minDistance > distance ||
 					closestSpeedpad == nullptr)
 				{
 					minDistance = distance;
-					closestSpeedpad = actor;
+					closestSpeedpad = speedpad.Get();
 				}
 			}
+		}
 
-			// Collect the closest speed pad from this vehicle.
+		// Collect the closest speed pad from this vehicle.
 
-			(Cast<ASpeedPad>(closestSpeedpad))->OnSpeedPadCollected(this);
+		if (closestSpeedpad != nullptr)
+		{
+			closestSpeedpad->OnSpeedPadCollected(this);
 		}
 	}
 }
@@ -295,17 +291,14 @@ bool ABaseVehicle::SpeedBoost(ASpeedPad* speedpad, float amount, float duration,
 
 void ABaseVehicle::CollectPickups()
 {
-	if (GRIP_OBJECT_VALID(VehicleCollision) == true)
+	if (OverlappingPickups.Num() > 0)
 	{
-		TSet<AActor*> collectedActors;
-
-		VehicleCollision->GetOverlappingActors(collectedActors, APickup::StaticClass());
-
-		for (AActor* actor : collectedActors)
+		for (int32 i = 0; i < OverlappingPickups.Num(); i++)
 		{
-			APickup* pickup = Cast<APickup>(actor);
+			APickup* pickup = OverlappingPickups[i].Get();
 
-			if (pickup->IsCollectible() == true)
+			if (GRIP_OBJECT_VALID(pickup) == true &&
+				pickup->IsCollectible() == true)
 			{
 				if (pickup->Class == EPickupClass::Pickup)
 				{
@@ -366,6 +359,62 @@ void ABaseVehicle::CollectPickups()
 	}
 }
 
+/**
+* Handle the vehicle's collision shell beginning to overlap a speed pad or pickup.
+*
+* The engine already tracks the overlaps of the collision shell, so we just keep
+* our own short lists of the pads within it rather than asking for a freshly
+* allocated set of the overlapping actors every frame.
+***********************************************************************************/
+
+void ABaseVehicle::OnPadBeginOverlap(class UPrimitiveComponent* overlappedComponent, class AActor* otherActor, class UPrimitiveComponent* otherComponent, int32 otherBodyIndex, bool fromSweep, const FHitResult& sweepResult)
+{
+	ASpeedPad* speedpad = Cast<ASpeedPad>(otherActor);
+
+	if (speedpad != nullptr)
+	{
+		OverlappingSpeedPads.AddUnique(speedpad);
+	}
+
+	APickup* pickup = Cast<APickup>(otherActor);
+
+	if (pickup != nullptr)
+	{
+		OverlappingPickups.AddUnique(pickup);
+	}
+}
+
+/**
+* Handle the vehicle's collision shell ending its overlap with a speed pad or
+* pickup.
+***********************************************************************************/
+
+void ABaseVehicle::OnPadEndOverlap(class UPrimitiveComponent* overlappedComponent, class AActor* otherActor, class UPrimitiveComponent* otherComponent, int32 otherBodyIndex)
+{
+	// An actor can overlap through more than one of its components, so only forget
+	// about it once none of them overlap any more.
+
+	if (GRIP_OBJECT_VALID(VehicleCollision) == true &&
+		VehicleCollision->IsOverlappingActor(otherActor) == true)
+	{
+		return;
+	}
+
+	ASpeedPad* speedpad = Cast<ASpeedPad>(otherActor);
+
+	if (speedpad != nullptr)
+	{
+		OverlappingSpeedPads.RemoveSingleSwap(speedpad, false);
+	}
+
+	APickup* pickup = Cast<APickup>(otherActor);
+
+	if (pickup != nullptr)
+	{
+		OverlappingPickups.RemoveSingleSwap(pickup, false);
+	}
+}
+
 #pragma endregion PickupPads
 
 #pragma region VehiclePickups
@@ -392,21 +441,8 @@ void ABaseVehicle::UpdatePickupSlots(float deltaSeconds)
 		{
 			// Make sure we have some humans left to hit.
 
-			bool haveHumans = false;
-
-			GRIP_GAME_MODE_LIST_FROM(GetVehicles(), vehicles, PlayGameMode);
-
-			for (ABaseVehicle* vehicle : vehicles)
-			{
-				if (vehicle->IsAIVehicle() == false &&
-					vehicle->IsVehicleDestroyed() == false)
-				{
-					haveHumans = true;
-					break;
-				}
-			}
-
-			if (haveHumans == false)
+			if (PlayGameMode != nullptr &&
+				PlayGameMode->HasLiveHumanVehicles() == false)
 			{
 				PickupSlots[i].BotWillTargetHuman = false;
 			}
@@ -652,14 +688,14 @@ void ABaseVehicle::UsePickup(int32 pickupSlot, EPickupActivation activation, boo
 					{
 						if (Level2TurboBlueprint != nullptr)
 						{
-							turbo = GetWorld()->SpawnActor<ATurbo>(Level2TurboBlueprint, VehicleMesh->GetComponentLocation(), VehicleMesh->GetComponentRotation(), spawnParams);
+							turbo = PlayGameMode->GetActorPool().Acquire<ATurbo>(GetWorld(), Level2TurboBlueprint, VehicleMesh->GetComponentLocation(), VehicleMesh->GetComponentRotation(), spawnParams);
 						}
 					}
 					else
 					{
 						if (Level1TurboBlueprint != nullptr)
 						{
-							turbo = GetWorld()->SpawnActor<ATurbo>(Level1TurboBlueprint, VehicleMesh->GetComponentLocation(), VehicleMesh->GetComponentRotation(), spawnParams);
+							turbo = PlayGameMode->GetActorPool().Acquire<ATurbo>(GetWorld(), Level1TurboBlueprint, VehicleMesh->GetComponentLocation(), VehicleMesh->GetComponentRotation(), spawnParams);
 						}
 					}
 
@@ -708,14 +744,14 @@ void ABaseVehicle::UsePickup(int32 pickupSlot, EPickupActivation activation, boo
 					{
 						if (Level2GatlingGunBlueprint != nullptr)
 						{
-							gatlingGun = GetWorld()->SpawnActor<AGatlingGun>(Level2GatlingGunBlueprint, VehicleMesh->GetComponentLocation(), VehicleMesh->GetComponentRotation(), spawnParams);
+							gatlingGun = PlayGameMode->GetActorPool().Acquire<AGatlingGun>(GetWorld(), Level2GatlingGunBlueprint, VehicleMesh->GetComponentLocation(), VehicleMesh->GetComponentRotation(), spawnParams);
 						}
 					}
 					else
 					{
 						if (Level1GatlingGunBlueprint != nullptr)
 						{
-							gatlingGun = GetWorld()->SpawnActor<AGatlingGun>(Level1GatlingGunBlueprint, VehicleMesh->GetComponentLocation(), VehicleMesh->GetComponentRotation(), spawnParams);
+							gatlingGun = PlayGameMode->GetActorPool().Acquire<AGatlingGun>(GetWorld(), Level1GatlingGunBlueprint, VehicleMesh->GetComponentLocation(), VehicleMesh->GetComponentRotation(), spawnParams);
 						}
 					}
 
@@ -1844,6 +1880,10 @@ FVector ABaseVehicle::EjectGunRound(int32 roundLocation, bool charged)
 
 	FName muzzleLocation = ((roundLocation == 0) ? "MachineGun_L" : "MachineGun_R");
 
+	// The muzzle flash isn't taken from the world's particle system pool like the shell
+	// ejection below, as pooled components have no owner and it needs to be hidden from
+	// its owner in cockpit view.
+
 	UParticleSystemComponent* muzzleFlash = SpawnParticleSystem(VehicleGun->MuzzleFlashEffect, muzzleLocation, FVector::ZeroVector, FRotator::ZeroRotator, EAttachLocation::KeepRelativeOffset, (charged == true) ? 2.0f : 1.0f);
 
 	muzzleFlash->SetOwnerNoSee(IsCockpitView());
@@ -1862,9 +1902,15 @@ FVector ABaseVehicle::EjectGunRound(int32 roundLocation, bool charged)
 
 	velocity += GetVelocity() * 0.9f;
 
-	UParticleSystemComponent* shellEjection = SpawnParticleSystem(VehicleGun->ShellEjectEffect, shellLocation, FVector::ZeroVector, FRotator(0.0f, -90.0f, 0.0f), EAttachLocation::KeepRelativeOffset, 1.0f);
+	// These are spawned for every round fired, so they come from the world's particle
+	// system pool rather than being created and destroyed each time.
+
+	UParticleSystemComponent* shellEjection = SpawnPooledParticleSystem(VehicleGun->ShellEjectEffect, shellLocation, FVector::ZeroVector, FRotator(0.0f, -90.0f, 0.0f), 1.0f);
 
-	shellEjection->SetVectorParameter(FName("ShellVelocity"), velocity);
+	if (shellEjection != nullptr)
+	{
+		shellEjection->SetVectorParameter(FName("ShellVelocity"), velocity);
+	}
 
 	// Spawn the round firing sound.
 
@@ -2138,7 +2184,32 @@ void ABaseVehicle::PeripheralExplosionForce(float strength, int32 hitPoints, int
 
 void ABaseVehicle::PeripheralExplosionForce(float strength, int32 hitPoints, int32 aggressorVehicleIndex, const FVector& location, bool limitForces, FColor color, ABaseVehicle* avoid, UWorld* world, float radius)
 {
-	GRIP_GAME_MODE_LIST_FOR(GetVehicles(), vehicles, world);
+	FVehicleBroadphase::FVehicleList vehicles;
+	APlayGameMode* gameMode = APlayGameMode::Get(world);
+
+	if (gameMode != nullptr)
+	{
+		// Only consider the vehicles that could possibly be within range of the explosion.
+
+		gameMode->GetVehicleBroadphase().QueryNeighbours(location, radius * 2.0f, vehicles);
+	}
+	else
+	{
+		// There's no broadphase outside of a play game mode, so consider every vehicle.
+
+		for (TActorIterator<ABaseVehicle> actorItr(world); actorItr; ++actorItr)
+		{
+			vehicles.Emplace(*actorItr);
+		}
+	}
+
+	// Apply the forces in vehicle index order, so that it doesn't depend on the race
+	// positions of the vehicles or on how they happen to be found above.
+
+	vehicles.Sort([] (const ABaseVehicle& object1, const ABaseVehicle& object2)
+		{
+			return object1.GetVehicleIndex() < object2.GetVehicleIndex();
+		});
 
 	for (ABaseVehicle* vehicle : vehicles)
 	{
@@ -2253,20 +2324,15 @@ void ABaseVehicle::UpdateMissiles(float deltaSeconds)
 			viewVehicle = this;
 		}
 
-		FVector location = viewVehicle->GetActorLocation();
-
-		GRIP_GAME_MODE_LIST_FROM(Missiles, missiles, PlayGameMode);
+		ABaseVehicle* viewedVehicle = Cast<ABaseVehicle>(viewVehicle);
 
-		for (AHomingMissile* missile : missiles)
+		if (viewedVehicle != nullptr)
 		{
-			if (missile->Target == viewVehicle &&
-				missile->IsHoming() == true)
+			for (const FIncomingThreat& threat : viewedVehicle->GetIncomingThreats())
 			{
-				float distance = (missile->GetActorLocation() - location).Size();
-
-				if (minDistance > distance)
+				if (threat.Homing == true)
 				{
-					minDistance = distance;
+					minDistance = FMath::Min(minDistance, threat.Distance);
 				}
 			}
 		}
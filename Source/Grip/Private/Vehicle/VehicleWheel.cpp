@@ -97,3 +97,88 @@ void FWheelDrivingSurfaces::DiscardComponent(FWheelDrivingSurface& surface)
 }
 
 #pragma endregion VehicleSurfaceEffects
+
+#pragma region VehicleContactSensors
+
+/**
+* Set the number of wheels in use, clearing all of the data.
+***********************************************************************************/
+
+void FVehicleWheelsHotData::SetNumWheels(int32 numWheels)
+{
+	// The vehicle should never have set up more wheels than we can hold, but clamp
+	// anyway as this needs to be safe in shipping builds too.
+
+	ensureAlways(numWheels <= MaxWheels);
+
+	NumWheels = FMath::Clamp(numWheels, 0, MaxWheels);
+
+	// Clear everything, including the padding lanes beyond the last wheel, so that
+	// we never process uninitialized values in the vector operations.
+
+	FMemory::Memzero(LocationX);
+	FMemory::Memzero(LocationY);
+	FMemory::Memzero(LocationZ);
+	FMemory::Memzero(VelocityX);
+	FMemory::Memzero(VelocityY);
+	FMemory::Memzero(VelocityZ);
+	FMemory::Memzero(HorizontalVelocityX);
+	FMemory::Memzero(HorizontalVelocityY);
+	FMemory::Memzero(HorizontalVelocityZ);
+	FMemory::Memzero(SpeedSquared);
+}
+
+/**
+* Calculate the velocities of all of the wheels from the rigid body state of the
+* vehicle.
+*
+* This is the same calculation the physics engine does for the velocity at a point,
+* linear velocity + angular velocity x (point - center of mass), but done here for
+* four wheels at a time without having to go through the physics interface for each
+* of them.
+***********************************************************************************/
+
+void FVehicleWheelsHotData::CalculateVelocities(const FVector& linearVelocity, const FVector& angularVelocity, const FVector& centerOfMass, const FVector& upDirection)
+{
+	const VectorRegister lx = VectorSetFloat1(linearVelocity.X);
+	const VectorRegister ly = VectorSetFloat1(linearVelocity.Y);
+	const VectorRegister lz = VectorSetFloat1(linearVelocity.Z);
+	const VectorRegister ax = VectorSetFloat1(angularVelocity.X);
+	const VectorRegister ay = VectorSetFloat1(angularVelocity.Y);
+	const VectorRegister az = VectorSetFloat1(angularVelocity.Z);
+	const VectorRegister cx = VectorSetFloat1(centerOfMass.X);
+	const VectorRegister cy = VectorSetFloat1(centerOfMass.Y);
+	const VectorRegister cz = VectorSetFloat1(centerOfMass.Z);
+	const VectorRegister ux = VectorSetFloat1(upDirection.X);
+	const VectorRegister uy = VectorSetFloat1(upDirection.Y);
+	const VectorRegister uz = VectorSetFloat1(upDirection.Z);
+
+	for (int32 i = 0; i < NumWheels; i += VectorWidth)
+	{
+		// The offset of the wheels from the center of mass.
+
+		VectorRegister rx = VectorSubtract(VectorLoad(LocationX + i), cx);
+		VectorRegister ry = VectorSubtract(VectorLoad(LocationY + i), cy);
+		VectorRegister rz = VectorSubtract(VectorLoad(LocationZ + i), cz);
+
+		// The velocity of the wheels, linear velocity + angular velocity x offset.
+
+		VectorRegister vx = VectorAdd(lx, VectorSubtract(VectorMultiply(ay, rz), VectorMultiply(az, ry)));
+		VectorRegister vy = VectorAdd(ly, VectorSubtract(VectorMultiply(az, rx), VectorMultiply(ax, rz)));
+		VectorRegister vz = VectorAdd(lz, VectorSubtract(VectorMultiply(ax, ry), VectorMultiply(ay, rx)));
+
+		// Remove the component of the velocities along the up direction of the vehicle.
+
+		VectorRegister up = VectorMultiplyAdd(vz, uz, VectorMultiplyAdd(vy, uy, VectorMultiply(vx, ux)));
+
+		VectorStore(vx, VelocityX + i);
+		VectorStore(vy, VelocityY + i);
+		VectorStore(vz, VelocityZ + i);
+		VectorStore(VectorSubtract(vx, VectorMultiply(ux, up)), HorizontalVelocityX + i);
+		VectorStore(VectorSubtract(vy, VectorMultiply(uy, up)), HorizontalVelocityY + i);
+		VectorStore(VectorSubtract(vz, VectorMultiply(uz, up)), HorizontalVelocityZ + i);
+		VectorStore(VectorMultiplyAdd(vz, vz, VectorMultiplyAdd(vy, vy, VectorMultiply(vx, vx))), SpeedSquared + i);
+	}
+}
+
+#pragma endregion VehicleContactSensors
@@ -54,10 +54,18 @@ public:
 	float GetRandom() const
 	{ return (Minimum == Maximum) ? Minimum : FMath::FRandRange(Minimum, Maximum); }
 
+	// Get a random number within the minimum and maximum range, drawn from a given random number generator.
+	float GetRandom(FMathEx::FRandomBlock& random) const
+	{ return (Minimum == Maximum) ? Minimum : random.GetRange(Minimum, Maximum); }
+
 	// Generate a random number within the minimum and maximum range and store it away in our internal value.
 	float GenerateRandom()
 	{ Value = GetRandom(); return Value; }
 
+	// Generate a random number within the minimum and maximum range, drawn from a given random number generator, and store it away in our internal value.
+	float GenerateRandom(FMathEx::FRandomBlock& random)
+	{ Value = GetRandom(random); return Value; }
+
 	// The minimum extent of the range.
 	UPROPERTY(EditAnywhere, Category = Default)
 		float Minimum = 0.0f;
@@ -185,6 +193,10 @@ public:
 	UPROPERTY(EditAnywhere, Category = Streak, meta = (EditCondition = "Streak"))
 		UMaterialInterface* StreakMaterial = nullptr;
 
+	// The seed for all of the random numbers drawn by the streak, for its end selection, shape, width and timing, 0 for a different seed every game.
+	UPROPERTY(EditAnywhere, Category = Streak, meta = (EditCondition = "Streak"))
+		int32 RandomSeed = 0;
+
 	// Use a flare?
 	UPROPERTY(EditAnywhere, Category = Flare)
 		bool Flare = true;
@@ -230,7 +242,7 @@ public:
 	{
 		Super::BeginPlay();
 
-		Timer = -InitialDelay.Get(); ThisLifeTime = LifeTime.GetRandom(); RespawnAt = ThisLifeTime + PostDelay.GetRandom();
+		Timer = -InitialDelay.Get(); ThisLifeTime = LifeTime.GetRandom(Random); RespawnAt = ThisLifeTime + PostDelay.GetRandom(Random);
 	}
 
 	// Do the regular update tick.
@@ -329,6 +341,13 @@ protected:
 	// The line segments used in the generation of electricity.
 	TArray<FLineSegment> Segments[2];
 
+	// The random number streams used for everything random about the streak.
+	FMathEx::FRandomBlock Random;
+
+	// The random rolls and offsets for the midpoints of each subdivision of the line segments.
+	TArray<float> RandomRolls;
+	TArray<float> RandomOffsets;
+
 	// Is this component currently enabled?
 	bool Enabled = true;
 
@@ -19,13 +19,24 @@
 #include "system/timesmoothing.h"
 #include "system/mathhelpers.h"
 #include "system/timeshareclock.h"
+#include "system/aiworkscheduler.h"
+#include "system/trackspatialindex.h"
+#include "system/vehiclebroadphase.h"
+#include "system/visibilityqueryservice.h"
+#include "system/combataffinitymatrix.h"
+#include "system/threatregistry.h"
+#include "system/actorpool.h"
+#include "system/gunroundmanager.h"
+#include "system/gridbenchmark.h"
 #include "system/avoidable.h"
 #include "gamemodes/basegamemode.h"
 #include "effects/drivingsurfacecharacteristics.h"
 #include "pickups/pickup.h"
+#include "vehicle/vehiclephysics.h"
 #include "playgamemode.generated.h"
 
 struct FPlayerPickupSlot;
+struct FPlayerRaceState;
 
 class UWidget;
 class UPursuitSplineComponent;
@@ -416,6 +427,49 @@ public:
 		FGameModesPickupAssignmentRatios PickupAssignmentRatios;
 };
 
+#pragma region VehicleCollision
+
+/**
+* The types of contact policy for an actor, describing how a vehicle should treat
+* contacts with it.
+***********************************************************************************/
+
+enum class EActorContactPolicy : uint8
+{
+	// General scenery, the default for any actor that hasn't been registered.
+	Scenery,
+
+	// Another vehicle.
+	Vehicle,
+
+	// A frictional actor, which limits the collision response of a vehicle.
+	Frictional
+};
+
+/**
+* The contact policy for an actor, determined once when the actor registers with
+* the game mode so that contact modification on the physics thread doesn't need to
+* inspect the actor itself.
+***********************************************************************************/
+
+struct FActorContactPolicy
+{
+	FActorContactPolicy() = default;
+
+	FActorContactPolicy(EActorContactPolicy policy, ABaseVehicle* vehicle = nullptr)
+		: Policy(policy)
+		, Vehicle(vehicle)
+	{ }
+
+	// The type of contact policy for the actor.
+	EActorContactPolicy Policy = EActorContactPolicy::Scenery;
+
+	// The actor as a vehicle, if it is one, so that it doesn't need to be cast.
+	ABaseVehicle* Vehicle = nullptr;
+};
+
+#pragma endregion VehicleCollision
+
 /**
 * Overrides, just used for easy testing, not present in shipping builds.
 ***********************************************************************************/
@@ -602,6 +656,43 @@ public:
 	TArray<ABaseVehicle*>& GetVehicles()
 	{ if (Vehicles.Num() == 0) DetermineVehicles(); return Vehicles; }
 
+	// Get the frame snapshots of the vehicles currently present in the game, indexed by vehicle index.
+	// These are all written at once at the end of the frame in the game mode tick, so they
+	// describe the last frame and can safely be read from worker threads launched at any other time.
+	const FVehicleFrameSnapshots& GetVehicleSnapshots() const
+	{ return VehicleSnapshots; }
+
+	// Get the frame snapshot of a vehicle, or a default snapshot if it hasn't yet been published.
+	const FVehicleFrameSnapshot& GetVehicleSnapshot(int32 vehicleIndex) const
+	{ static const FVehicleFrameSnapshot defaultSnapshot; return (VehicleSnapshots.IsValidIndex(vehicleIndex) == true) ? VehicleSnapshots[vehicleIndex] : defaultSnapshot; }
+
+	// Publish the frame snapshot of a vehicle to the fleet-wide array of snapshots, only from UpdateVehicleSnapshots.
+	void SetVehicleSnapshot(int32 vehicleIndex, const FVehicleFrameSnapshot& snapshot)
+	{ check(IsInGameThread()); if (vehicleIndex >= 0) { if (VehicleSnapshots.Num() <= vehicleIndex) VehicleSnapshots.SetNum(vehicleIndex + 1); VehicleSnapshots[vehicleIndex] = snapshot; } }
+
+	// Get the scheduler for the AI work of the vehicles.
+	FAIWorkScheduler& GetAIWorkScheduler()
+	{ return AIWorkScheduler; }
+
+	// Get the proximity broadphase for vehicle-to-vehicle queries.
+	const FVehicleBroadphase& GetVehicleBroadphase();
+
+	// Get the service for asynchronous line-of-sight queries.
+	FVisibilityQueryService& GetVisibilityQueryService()
+	{ return VisibilityQueryService; }
+
+	// Get the registry of threats incoming on the vehicles.
+	const FThreatRegistry& GetThreatRegistry() const
+	{ return ThreatRegistry; }
+
+	// Get the pool that pickups and their effects are recycled through.
+	FActorPool& GetActorPool()
+	{ return ActorPool; }
+
+	// Get the manager for all of the live gun rounds in the game.
+	FGunRoundManager& GetGunRoundManager()
+	{ return GunRoundManager; }
+
 	// Get the pursuit splines currently present in the game.
 	TArray<APursuitSplineActor*>& GetPursuitSplines()
 	{ if (PursuitSplines.Num() == 0) DeterminePursuitSplines(); return PursuitSplines; }
@@ -655,9 +746,15 @@ public:
 	// Avoidables is a map because looking up an interface at run-time is expensive.
 	TMap<AActor*, IAvoidableInterface*> Avoidables;
 
+	// The attractables indexed by their position along the master racing spline.
+	TTrackSpatialIndex<IAttractableInterface> AttractablesIndex;
+
+	// The avoidables indexed by their position along the master racing spline.
+	TTrackSpatialIndex<IAvoidableInterface> AvoidablesIndex;
+
 	// Collect a race finishing position when a player crosses the line.
 	int32 CollectFinishingRacePosition()
-	{ return FMath::Min(NextFinishingRacePosition++, GRIP_MAX_PLAYERS - 1); }
+	{ return FMath::Min(NextFinishingRacePosition++, FMath::Max(Vehicles.Num(), 1) - 1); }
 
 	// Collect a death position when a player is eliminated from a game.
 	int32 CollectDeathPosition()
@@ -668,19 +765,19 @@ public:
 
 	// Add an avoidable to the list of avoidables present in the current level.
 	void AddAvoidable(AActor* actor)
-	{ if (Avoidables.Contains(actor) == false) Avoidables.Emplace(actor, Cast<IAvoidableInterface>(actor)); }
+	{ if (Avoidables.Contains(actor) == false) { IAvoidableInterface* avoidable = Cast<IAvoidableInterface>(actor); Avoidables.Emplace(actor, avoidable); AvoidablesIndex.Add(actor, avoidable); } }
 
 	// Remove an avoidable from the list of avoidables present in the current level.
 	void RemoveAvoidable(AActor* actor)
-	{ if (Avoidables.Contains(actor) == true) { Avoidables.Remove(actor); Avoidables.Compact(); } }
+	{ if (Avoidables.Contains(actor) == true) { Avoidables.Remove(actor); Avoidables.Compact(); AvoidablesIndex.Remove(actor); } }
 
 	// Add an attractable to the list of attractables present in the current level.
 	void AddAttractable(AActor* actor)
-	{ if (Attractables.Contains(actor) == false) Attractables.Emplace(actor, Cast<IAttractableInterface>(actor)); }
+	{ if (Attractables.Contains(actor) == false) { IAttractableInterface* attractable = Cast<IAttractableInterface>(actor); Attractables.Emplace(actor, attractable); AttractablesIndex.Add(actor, attractable); } }
 
 	// Remove an attractable from the list of attractables present in the current level.
 	void RemoveAttractable(AActor* actor)
-	{ if (Attractables.Contains(actor) == true) { Attractables.Remove(actor); Attractables.Compact(); } }
+	{ if (Attractables.Contains(actor) == true) { Attractables.Remove(actor); Attractables.Compact(); AttractablesIndex.Remove(actor); } }
 
 	// Determine the vehicles that are currently present in the level.
 	void DetermineVehicles();
@@ -694,6 +791,9 @@ public:
 	// Convert a master racing spline distance to a lap distance.
 	float MasterRacingSplineDistanceToLapDistance(float distance);
 
+	// Get the number of checkpoints that might be crossed moving between two master racing spline distances.
+	int32 NumCheckpointsBetween(float fromDistance, float toDistance, bool crossedSplineStart) const;
+
 	// Determine the master racing spline.
 	static UPursuitSplineComponent* DetermineMasterRacingSpline(const FName& navigationLayer, UWorld* world, UGlobalGameState* gameState);
 
@@ -704,7 +804,7 @@ public:
 	static void EstablishPursuitSplineLinks(bool check, const FName& navigationLayer, UWorld* world, UGlobalGameState* gameState, UPursuitSplineComponent* masterRacingSpline);
 
 	// List of the last few frame times, used to determine an average, recent frame rate.
-	FTimedFloatList FrameTimes = FTimedFloatList(1, 30);
+	TFixedTimedValueList<float, 32> FrameTimes = TFixedTimedValueList<float, 32>(1, 30, true, false, true);
 
 	// Get the play game mode for the current world.
 	static APlayGameMode* Get(const UObject* worldContextObject)
@@ -720,10 +820,20 @@ public:
 	// The distance around the master racing spline of the start line.
 	float MasterRacingSplineStartDistance = 0.0f;
 
+	// The distances around the master racing spline of the checkpoints, sorted in ascending order.
+	TArray<float> CheckpointDistances;
+
 	// The ratio around the last lap, between 0 and 1, 0 being before or at the beginning of the lap and 1 meaning the lap is complete.
 	// This is normally used to scale back the aggression of the bots during the last lap to give you a better chance of winning.
 	float LastLapRatio = 0.0f;
 
+	// The race states of all of the vehicles, kept in race distance order between frames
+	// so that it only needs a little repair each frame rather than a full sort.
+	TArray<FPlayerRaceState*> RaceDistanceOrder;
+
+	// The race states of all of the vehicles, kept in eternal race distance order between frames.
+	TArray<FPlayerRaceState*> EternalRaceDistanceOrder;
+
 	// The last time the options were set within the game.
 	// This is used to optimize the HUD rendering.
 	float LastOptionsResetTime = 0.0f;
@@ -741,19 +851,50 @@ public:
 public:
 
 	// Should an actor actively limit the collision response when a vehicle collides with it?
-	bool ShouldActorLimitCollisionResponse(AActor* actor);
+	bool ShouldActorLimitCollisionResponse(AActor* actor) const
+	{ return GetContactPolicy(actor).Policy == EActorContactPolicy::Frictional; }
+
+#endif // GRIP_ANTI_SKYWARD_LAUNCH
+
+#pragma endregion VehiclePhysicsTweaks
+
+#pragma region VehicleCollision
+
+public:
+
+	// Add the contact policy for an actor that vehicles may come into contact with.
+	void AddContactPolicy(const AActor* actor, const FActorContactPolicy& policy)
+	{ check(IsInGameThread()); PendingContactPolicies.Emplace(actor, policy); ContactPoliciesChanged = true; }
+
+	// Remove the contact policy for an actor.
+	void RemoveContactPolicy(const AActor* actor)
+	{ check(IsInGameThread()); if (PendingContactPolicies.Remove(actor) != 0) ContactPoliciesChanged = true; }
+
+	// Get the contact policy for an actor, this is safe to call from the physics thread.
+	FActorContactPolicy GetContactPolicy(const AActor* actor) const
+	{ const FActorContactPolicy* policy = ContactPolicies.Find(actor); return (policy != nullptr) ? *policy : FActorContactPolicy(); }
 
 private:
 
-	// Result of the last frictional actor check, cached for optimization.
-	bool LastFrictionalActorCheckResult = false;
+	// Publish the contact policies changed on the game thread for the physics thread to read.
+	void PublishContactPolicies(UWorld* world, ELevelTick tickType, float deltaSeconds);
 
-	// The last frictional actor that was checked.
-	TWeakObjectPtr<AActor> LastFrictionalActorCheck;
+	// The contact policies for the actors registered with the game mode, as read from the
+	// physics thread. This is a map because we want to avoid casting actors on the physics
+	// thread, and it's only ever replaced at the start of a frame when the physics isn't
+	// running, so it can be read without any locking.
+	TMap<const AActor*, FActorContactPolicy> ContactPolicies;
 
-#endif // GRIP_ANTI_SKYWARD_LAUNCH
+	// The contact policies as they're being added and removed on the game thread.
+	TMap<const AActor*, FActorContactPolicy> PendingContactPolicies;
 
-#pragma endregion VehiclePhysicsTweaks
+	// Have the pending contact policies changed since they were last published?
+	bool ContactPoliciesChanged = false;
+
+	// The handle for publishing the contact policies at the start of each frame.
+	FDelegateHandle PublishContactPoliciesHandle;
+
+#pragma endregion VehicleCollision
 
 #pragma region VehicleAudio
 
@@ -803,6 +944,13 @@ public:
 	// -1 means no, 0 mean yes, +1 mean hell yeah!
 	float VehicleShouldFightVehicle(ABaseVehicle* aggressor, ABaseVehicle* victim);
 
+	// Get the combat flags for a vehicle, as of the last update of the combat affinities.
+	FVehicleCombatFlags GetVehicleCombatFlags(ABaseVehicle* vehicle) const;
+
+	// Are there any human vehicles not yet destroyed, as of the last update of the combat affinities?
+	bool HasLiveHumanVehicles() const
+	{ return NumLiveHumanVehicles != 0; }
+
 	// Should a pickup be used?
 	bool ShouldUsePickup(bool isBot, const FPlayerPickupSlot* pickup, float aggressionRatio) const;
 
@@ -822,9 +970,21 @@ public:
 
 private:
 
+	// Calculate whether a vehicle should be fighting another vehicle, ignoring the combat affinities.
+	float CalculateVehicleShouldFightVehicle(ABaseVehicle* aggressor, ABaseVehicle* victim);
+
+	// Update the combat affinities of all the vehicles against each other.
+	void UpdateCombatAffinities();
+
+	// Pre-warm the actor pool with the pickups and effects the game is likely to need.
+	void PrewarmActorPool();
+
 	// The number of pickups of each type currently present.
 	TArray<int32> NumPickupTypes;
 
+	// The combat affinities of all the vehicles against each other, updated once per frame.
+	FCombatAffinityMatrix CombatAffinities;
+
 	// The time each pickup type was last used.
 	TArray<float> LastUsedPickupTypes;
 
@@ -855,6 +1015,21 @@ private:
 	// Calculate the race positions for each of the vehicles.
 	void UpdateRacePositions(float deltaSeconds);
 
+	// Add player starts behind the existing grid so that there's room for a grid benchmark.
+	void AddBenchmarkStartpoints(int32 numStartpoints);
+
+	// Repair the orders of the race states held between frames.
+	void UpdateRaceOrders();
+
+	// Update the scheduler for the AI work of the vehicles.
+	void UpdateAIWorkScheduler(float deltaSeconds);
+
+	// Update the frame snapshots of all of the vehicles.
+	void UpdateVehicleSnapshots();
+
+	// Update the spatial indices of the attractables and avoidables.
+	void UpdateSpatialIndices();
+
 	// Upload the loading of the main UI.
 	void UpdateUILoading();
 
@@ -907,6 +1082,33 @@ private:
 	// This is used to help calculate the relative volume level of each of the vehicles effectively.
 	TArray<ABaseVehicle*> WatchedVehicles;
 
+	// The frame snapshots of the vehicles currently present in the game, indexed by vehicle index.
+	FVehicleFrameSnapshots VehicleSnapshots;
+
+	// The scheduler for the AI work of the vehicles.
+	FAIWorkScheduler AIWorkScheduler;
+
+	// The proximity broadphase for vehicle-to-vehicle queries, built once per frame.
+	FVehicleBroadphase VehicleBroadphase;
+
+	// The service for asynchronous line-of-sight queries.
+	FVisibilityQueryService VisibilityQueryService;
+
+	// The registry of threats incoming on the vehicles, updated once per frame.
+	FThreatRegistry ThreatRegistry;
+
+	// The pool that pickups and their effects are recycled through.
+	FActorPool ActorPool;
+
+	// The manager for all of the live gun rounds in the game.
+	FGunRoundManager GunRoundManager;
+
+	// The benchmark for measuring the scaling of the game with the size of the grid.
+	FGridBenchmark GridBenchmark;
+
+	// The number of human vehicles not yet destroyed, as of the last update of the combat affinities, or -1 if not yet known.
+	int32 NumLiveHumanVehicles = -1;
+
 	// The pawn that is currently the focus of the camera cycling system.
 	UPROPERTY(Transient)
 		APawn* ViewingPawn = nullptr;
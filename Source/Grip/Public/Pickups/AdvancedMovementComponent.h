@@ -19,6 +19,13 @@
 #include "system/mathhelpers.h"
 #include "advancedmovementcomponent.generated.h"
 
+class UPursuitSplineComponent;
+
+DECLARE_STATS_GROUP(TEXT("GRIP Terrain Probes"), STATGROUP_GripTerrainProbes, STATCAT_Advanced);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Terrain Probes"), STAT_TerrainProbes, STATGROUP_GripTerrainProbes, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Terrain Probes From Splines"), STAT_TerrainProbesFromSplines, STATGROUP_GripTerrainProbes, );
+DECLARE_FLOAT_COUNTER_STAT_EXTERN(TEXT("Terrain Traces Saved %"), STAT_TerrainTracesSaved, STATGROUP_GripTerrainProbes, );
+
 /**
 * Component for controlling advanced movement of other components.
 ***********************************************************************************/
@@ -94,6 +101,21 @@ public:
 	void SetInheritedRoll(float roll)
 	{ InheritedRoll = roll; }
 
+	// Set the pursuit spline whose clearance data is used to answer terrain probes, and
+	// the distance along it that the projectile is at.
+	void SetTerrainSpline(UPursuitSplineComponent* spline, float distance);
+
+	// Get the pursuit spline whose clearance data is used to answer terrain probes.
+	UPursuitSplineComponent* GetTerrainSpline() const
+	{ return TerrainSpline.Get(); }
+
+	// Probe for terrain between two points, answering from the terrain spline's
+	// clearance data where possible and only tracing when we can't.
+	bool ProbeTerrain(FHitResult& hitResult, const FVector& start, const FVector& end, ECollisionChannel channel, const FCollisionQueryParams& queryParams);
+
+	// Publish the statistics for the terrain probes made this frame.
+	static void UpdateTerrainProbeStats();
+
 	// Avoid and optionally hug the terrain towards a particular target location.
 	bool AvoidTerrain(float deltaSeconds, float terrainAvoidanceHeight, float forwardDistance, USceneComponent* targetComponent, const FVector& projectileLocation, const FVector& projectileDirection, FVector& terrainDirection, FVector& targetLocation, bool updateTerrainDirection);
 
@@ -128,6 +150,13 @@ protected:
 	// Merge the terrain avoidance factors into the general direction following.
 	FVector MergeTerrainAvoidance(const FVector& targetForward, FVector avoidingNormal, const FVector& originalDirection, const FVector& avoidingDirection);
 
+	// Update the distance along the terrain spline from the projectile's location.
+	void UpdateTerrainSpline(const FVector& location);
+
+	// Is a line segment known to be within the open space around the terrain spline,
+	// and therefore not hitting any terrain?
+	bool IsWithinSplineClearance(const FVector& start, const FVector& end) const;
+
 	// Timer used during the lifetime of the movement.
 	float Timer = 0.0f;
 
@@ -155,6 +184,21 @@ protected:
 	// Are we seeking a surface for terrain hugging? -1 for no, 0 or +1 for yes, depending on the seeking direction.
 	int32 SeekingSurface = -1;
 
+	// The pursuit spline whose clearance data is used to answer terrain probes.
+	TWeakObjectPtr<UPursuitSplineComponent> TerrainSpline;
+
+	// The distance along the terrain spline that the projectile is at.
+	float TerrainSplineDistance = 0.0f;
+
+	// The location the distance along the terrain spline was last updated for.
+	FVector TerrainSplineLocation = FVector::ZeroVector;
+
+	// The number of terrain probes made this frame, across all projectiles.
+	static int32 NumTerrainProbes;
+
+	// The number of terrain probes answered from spline clearance data this frame, across all projectiles.
+	static int32 NumTerrainProbesFromSplines;
+
 #pragma endregion PickupMissile
 
 };
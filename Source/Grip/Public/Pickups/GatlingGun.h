@@ -16,6 +16,7 @@
 #include "system/gameconfiguration.h"
 #include "effects/lightstreakcomponent.h"
 #include "pickupbase.h"
+#include "system/poolable.h"
 #include "gatlinggun.generated.h"
 
 struct FPlayerPickupSlot;
@@ -91,7 +92,7 @@ public:
 ***********************************************************************************/
 
 UCLASS(Abstract, ClassGroup = Pickups)
-class GRIP_API AGatlingGun : public APickupBase
+class GRIP_API AGatlingGun : public APickupBase, public IPoolableInterface
 {
 	GENERATED_BODY()
 
@@ -170,13 +171,20 @@ public:
 	// End manual firing of the gun, normally from a defense turret.
 	void EndFiring();
 
-	// Sweep along projectile direction to see if it hits something along the way.
-	bool GetCollision(UWorld* world, const FVector& start, const FVector& end, float& time, AActor* ignoreTarget);
+	// Get the launch platform for the gun.
+	AActor* GetLaunchPlatform() const
+	{ return LaunchPlatform.Get(); }
+
+	// Apply the hit of a round fired from the gun, once the gun round manager has traced it.
+	void RoundHit(const FHitResult& hitResult, const FVector& start, const FVector& end, AActor* target);
 
 	// Is the gun currently active?
 	bool IsActive() const
 	{ return Timer < Duration + WindUpTime + WindDownTime; }
 
+	// Reset the gun when it's returned to the actor pool.
+	virtual void OnReleasedToPool() override;
+
 	// Select a target for the gun.
 	static AActor* SelectTarget(AActor* launchPlatform, FPlayerPickupSlot* launchPickup, float autoAiming, float& weight, bool speculative);
 
@@ -225,9 +233,6 @@ private:
 	// The number of rounds that hit a vehicle.
 	int32 NumRoundsHitVehicle = 0;
 
-	// Hit result for the last round fired.
-	FHitResult HitResult;
-
 	// The world location of the last round impact point.
 	FVector LastImpact;
 
@@ -240,9 +245,6 @@ private:
 	// Halt the firing of rounds.
 	bool HaltRounds = false;
 
-	// Collision query for target visibility.
-	FCollisionQueryParams QueryParams;
-
 	// The vehicles hit by rounds from the gun.
 	TArray<ABaseVehicle*> HitVehicles;
 
@@ -364,6 +364,9 @@ private:
 	// Some random drift if not homing towards a target.
 	FVector2D RandomDrift = FVector2D(0.0f, 0.0f);
 
+	// The random number streams used for the launch and false targeting of the missile.
+	FMathEx::FRandomBlock Random;
+
 #pragma endregion PickupMissile
 
 	friend class ADebugMissileHUD;
@@ -19,6 +19,7 @@
 #include "system/commontypes.h"
 #include "system/attractable.h"
 #include "system/positionable.h"
+#include "system/poolable.h"
 #include "pickup.generated.h"
 
 class UPursuitSplineComponent;
@@ -48,7 +49,7 @@ enum class EPickupClass : uint8
 ***********************************************************************************/
 
 UCLASS(Abstract)
-class GRIP_API APickupEffect : public AActor
+class GRIP_API APickupEffect : public AActor, public IPoolableInterface
 {
 	GENERATED_BODY()
 
@@ -70,6 +71,9 @@ public:
 
 	// Handle the visual effects for a pickup collection.
 	void OnPickupPadCollected();
+
+	// Reset the effect when it's returned to the actor pool.
+	virtual void OnReleasedToPool() override;
 };
 
 /**
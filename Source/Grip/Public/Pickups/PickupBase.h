@@ -85,6 +85,9 @@ protected:
 	// Do some post initialization just before the game is ready to play.
 	virtual void PostInitializeComponents() override;
 
+	// Reset the pickup to its unused state, for when it's returned to the actor pool.
+	void ResetPickup();
+
 	// Which slot in the launch vehicle this pickup is assigned to.
 	int32 PickupSlot = 0;
 
@@ -15,6 +15,7 @@
 
 #include "system/gameconfiguration.h"
 #include "pickupbase.h"
+#include "system/poolable.h"
 #include "turbo.generated.h"
 
 struct FPlayerPickupSlot;
@@ -24,7 +25,7 @@ struct FPlayerPickupSlot;
 ***********************************************************************************/
 
 UCLASS(Abstract, ClassGroup = Pickups)
-class GRIP_API ATurbo : public APickupBase
+class GRIP_API ATurbo : public APickupBase, public IPoolableInterface
 {
 	GENERATED_BODY()
 
@@ -82,6 +83,9 @@ public:
 	bool IsActive() const
 	{ return Timer < Duration; }
 
+	// Reset the turbo when it's returned to the actor pool.
+	virtual void OnReleasedToPool() override;
+
 #pragma region BotCombatTraining
 
 	// Get a weighting, between 0 and 1, of how ideally a pickup can be used, optionally against a particular vehicle.
@@ -0,0 +1,204 @@
+/**
+*
+* A frame-budgeted scheduler for AI work.
+*
+* Original author: Rob Baker.
+* Current maintainer: Rob Baker.
+*
+* Copyright Caged Element Inc, code provided for educational purposes only.
+*
+* Expensive but non-critical AI work, like scanning for targets of opportunity or
+* validating the spline being followed, doesn't need to be done every frame. The
+* scheduler decides once per frame which vehicles get to do each type of work on
+* the next frame, in priority order and within a microsecond budget, while
+* guaranteeing that no work is deferred for longer than its maximum staleness.
+*
+***********************************************************************************/
+
+#pragma once
+
+#include "system/gameconfiguration.h"
+
+/**
+* The types of AI work that are scheduled.
+***********************************************************************************/
+
+enum class EAIWorkType : uint8
+{
+	// Fully determining the position on the splines being followed, and checking they're still valid.
+	RouteFollowing,
+
+	// Looking for attractables and targets of opportunity.
+	Opportunities,
+
+	// Tracing for a landing surface when roll control may be required.
+	RollControlTrace,
+
+	// Detecting whether a vehicle is stuck and needs to be teleported.
+	StuckDetection,
+
+	// Evaluating the efficacy of using a pickup.
+	PickupEfficacy,
+
+	// Evaluating the efficacy of using a pickup that's already been considered efficacious.
+	PickupEfficacyActive,
+
+	Num
+};
+
+/**
+* Statistics for the AI work scheduler, for the last frame scheduled.
+***********************************************************************************/
+
+struct FAIWorkSchedulerStats
+{
+	// The budget for the frame, in microseconds.
+	float BudgetMicroseconds = 0.0f;
+
+	// The estimated cost of the work scheduled for the frame, in microseconds.
+	float ScheduledMicroseconds = 0.0f;
+
+	// The measured cost of the work done in the frame, in microseconds.
+	float SpentMicroseconds = 0.0f;
+
+	// The number of work items granted for the frame.
+	int32 Granted = 0;
+
+	// The number of work items that were due but deferred to a later frame.
+	int32 Deferred = 0;
+
+	// The number of work items granted because they reached their maximum staleness.
+	int32 Forced = 0;
+
+	// The largest staleness of any work item at the point it was granted, in seconds.
+	float MaxStaleness = 0.0f;
+
+	// The number of frames where the measured cost exceeded the budget.
+	int32 Overruns = 0;
+};
+
+/**
+* A frame-budgeted scheduler for AI work.
+***********************************************************************************/
+
+class FAIWorkScheduler
+{
+public:
+
+	// Set the number of vehicles that AI work is scheduled for, indexed by vehicle index.
+	void SetNumVehicles(int32 numVehicles);
+
+	// Set the state used to prioritize the work for a vehicle.
+	void SetVehicleState(int32 vehicleIndex, float cameraDistance, int32 racePosition);
+
+	// Tick the scheduler at the end of a frame, to schedule the work for the next frame.
+	void Tick(float deltaSeconds);
+
+	// Should a type of AI work be done for a vehicle on this frame?
+	bool ShouldRunNow(int32 vehicleIndex, EAIWorkType type) const
+	{ return (VehicleSlots.IsValidIndex(vehicleIndex) == true) ? VehicleSlots[vehicleIndex].Work[(int32)type].RunNow : true; }
+
+	// Record the cost of doing a type of AI work, this may be called from any thread.
+	void RecordWork(EAIWorkType type, uint64 cycles)
+	{ FPlatformAtomics::InterlockedAdd(&CyclesThisFrame[(int32)type], (int64)cycles); FPlatformAtomics::InterlockedIncrement(&CountThisFrame[(int32)type]); }
+
+	// Get the statistics for the last frame scheduled.
+	const FAIWorkSchedulerStats& GetStats() const
+	{ return Stats; }
+
+	// Get the estimated cost of a type of AI work, in microseconds.
+	float GetEstimatedMicroseconds(EAIWorkType type) const
+	{ return EstimatedMicroseconds[(int32)type]; }
+
+	// The desired period between each type of AI work, in seconds.
+	static const float WorkPeriods[(int32)EAIWorkType::Num];
+
+	// The maximum period between each type of AI work, in seconds, even when over budget.
+	static const float MaxWorkStaleness[(int32)EAIWorkType::Num];
+
+private:
+
+	// The scheduling state for a type of AI work on a particular vehicle.
+	struct FAIWorkSlot
+	{
+		// The time since the work was last granted, in seconds.
+		float Staleness = 0.0f;
+
+		// Should the work be done on this frame?
+		bool RunNow = true;
+	};
+
+	// The scheduling state for all of the AI work on a particular vehicle.
+	struct FAIVehicleSlots
+	{
+		// The distance from the vehicle to the nearest local player camera.
+		float CameraDistance = 0.0f;
+
+		// The race position of the vehicle.
+		int32 RacePosition = 0;
+
+		// The scheduling state for each type of AI work.
+		FAIWorkSlot Work[(int32)EAIWorkType::Num];
+	};
+
+	// A work item that is due, for prioritizing against the budget.
+	struct FAIWorkCandidate
+	{
+		// The slot for the work.
+		FAIWorkSlot* Slot = nullptr;
+
+		// The type of the work.
+		EAIWorkType Type = EAIWorkType::RouteFollowing;
+
+		// The priority of the work, larger being more important.
+		float Priority = 0.0f;
+	};
+
+	// Get the priority of a work item that is due.
+	float GetPriority(const FAIVehicleSlots& vehicle, EAIWorkType type, float staleness) const;
+
+	// The scheduling state for each vehicle, indexed by vehicle index.
+	TArray<FAIVehicleSlots> VehicleSlots;
+
+	// The work items that are due, reused each frame to avoid allocations.
+	TArray<FAIWorkCandidate> Candidates;
+
+	// The estimated cost of each type of AI work, in microseconds.
+	float EstimatedMicroseconds[(int32)EAIWorkType::Num] = { 25.0f, 25.0f, 25.0f, 25.0f, 25.0f, 25.0f };
+
+	// The measured cycles spent on each type of AI work this frame.
+	volatile int64 CyclesThisFrame[(int32)EAIWorkType::Num] = { 0 };
+
+	// The number of each type of AI work done this frame.
+	volatile int32 CountThisFrame[(int32)EAIWorkType::Num] = { 0 };
+
+	// The statistics for the last frame scheduled.
+	FAIWorkSchedulerStats Stats;
+};
+
+/**
+* A scope for measuring the cost of AI work and recording it with the scheduler.
+***********************************************************************************/
+
+struct FAIWorkScope
+{
+	FAIWorkScope(FAIWorkScheduler* scheduler, EAIWorkType type)
+		: Scheduler(scheduler)
+		, Type(type)
+		, StartCycles((scheduler != nullptr) ? FPlatformTime::Cycles64() : 0)
+	{ }
+
+	~FAIWorkScope()
+	{ if (Scheduler != nullptr) Scheduler->RecordWork(Type, FPlatformTime::Cycles64() - StartCycles); }
+
+private:
+
+	// The scheduler to record the work with.
+	FAIWorkScheduler* Scheduler = nullptr;
+
+	// The type of the work being measured.
+	EAIWorkType Type = EAIWorkType::RouteFollowing;
+
+	// The cycle count at the start of the work.
+	uint64 StartCycles = 0;
+};
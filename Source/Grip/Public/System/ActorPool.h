@@ -0,0 +1,137 @@
+/**
+*
+* Actor pool.
+*
+* Original author: Rob Baker.
+* Current maintainer: Rob Baker.
+*
+* Copyright Caged Element Inc, code provided for educational purposes only.
+*
+* Pickups and their effects are used over and over again during a game, and
+* spawning and destroying an actor each time causes hitches on the spawn and
+* churns the garbage collector. Actors that implement the poolable interface are
+* instead returned to a pool, keyed by class, when they're finished with, and
+* reused the next time an actor of that class is asked for. The pool can be
+* pre-warmed at the start of a game so no spawns are needed during it.
+*
+* Pooling is off by default, grip.ActorPooling 1 switching it on, until it's
+* been measured to pay for itself. Run a race with the command line option
+* -GripActorPoolReport to measure the spawns, destroys and garbage collection
+* during it, reported to the log and appended to Saved/Profiling/GripActorPool.csv
+* at the end of the race, and compare the results with pooling on and off.
+*
+***********************************************************************************/
+
+#pragma once
+
+#include "system/gameconfiguration.h"
+
+DECLARE_STATS_GROUP(TEXT("GRIP Actor Pool"), STATGROUP_GripActorPool, STATCAT_Advanced);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Actor Pool Acquire"), STAT_ActorPoolAcquire, STATGROUP_GripActorPool, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Actor Pool Spawn"), STAT_ActorPoolSpawn, STATGROUP_GripActorPool, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Actor Pool Destroy"), STAT_ActorPoolDestroy, STATGROUP_GripActorPool, );
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Actor Pool Spawns"), STAT_ActorPoolSpawns, STATGROUP_GripActorPool, );
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Actor Pool Reuses"), STAT_ActorPoolReuses, STATGROUP_GripActorPool, );
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Actor Pool Destroys"), STAT_ActorPoolDestroys, STATGROUP_GripActorPool, );
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Actor Pool Free"), STAT_ActorPoolFree, STATGROUP_GripActorPool, );
+
+/**
+* Actor pool, keyed by class.
+***********************************************************************************/
+
+class FActorPool
+{
+public:
+
+	// Acquire an actor of a class from the pool, spawning a new one if there are none free.
+	template<typename ActorType>
+	ActorType* Acquire(UWorld* world, UClass* actorClass, const FVector& location, const FRotator& rotation, const FActorSpawnParameters& spawnParams)
+	{ return Cast<ActorType>(AcquireActor(world, actorClass, location, rotation, spawnParams)); }
+
+	// Release an actor back to the pool, or destroy it if it isn't poolable.
+	void Release(AActor* actor);
+
+	// Spawn enough actors of a class into the pool so that count of them are free.
+	void Prewarm(UWorld* world, UClass* actorClass, int32 count);
+
+	// Forget all of the actors in the pool.
+	void Reset()
+	{ FreeActors.Reset(); }
+
+	// Is pooling currently enabled?
+	static bool IsEnabled();
+
+	// Start measuring the cost of spawns, destroys and garbage collection, if requested on the command line.
+	void StartMeasuring();
+
+	// Stop measuring and report the results, if measuring.
+	void StopMeasuring(UWorld* world);
+
+private:
+
+	// Measurements of the cost of spawns, destroys and garbage collection over a race.
+	struct FMeasurements
+	{
+		// The number of actors spawned.
+		int32 NumSpawns = 0;
+
+		// The number of actors destroyed.
+		int32 NumDestroys = 0;
+
+		// The number of garbage collections.
+		int32 NumCollections = 0;
+
+		// The total cycles spent spawning actors.
+		uint64 SpawnCycles = 0;
+
+		// The most cycles spent spawning a single actor.
+		uint32 WorstSpawnCycles = 0;
+
+		// The total cycles spent destroying actors.
+		uint64 DestroyCycles = 0;
+
+		// The total cycles spent in garbage collection.
+		uint64 CollectionCycles = 0;
+
+		// The most cycles spent in a single garbage collection.
+		uint32 WorstCollectionCycles = 0;
+
+		// The cycle counter when the current garbage collection started.
+		uint32 CollectionStartCycles = 0;
+
+		// The number of UObjects in existence when measuring started.
+		int32 NumObjectsAtStart = 0;
+
+		// The time in seconds when measuring started.
+		double StartTime = 0.0;
+	};
+
+	// Handle the start of a garbage collection when measuring.
+	void OnPreGarbageCollect()
+	{ Measurements.CollectionStartCycles = FPlatformTime::Cycles(); }
+
+	// Handle the end of a garbage collection when measuring.
+	void OnPostGarbageCollect();
+
+	// Report the measurements to the log and the profiling CSV file.
+	void Report(UWorld* world) const;
+
+	// Acquire an actor of a class from the pool, spawning a new one if there are none free.
+	AActor* AcquireActor(UWorld* world, UClass* actorClass, const FVector& location, const FRotator& rotation, const FActorSpawnParameters& spawnParams);
+
+	// Put an actor into the pool, resetting it and taking it out of play.
+	void Deactivate(AActor* actor);
+
+	// The free actors in the pool, keyed by class.
+	TMap<UClass*, TArray<TWeakObjectPtr<AActor>>> FreeActors;
+
+	// Are we currently measuring?
+	bool Measuring = false;
+
+	// The measurements taken since measuring started.
+	FMeasurements Measurements;
+
+	// The handles for the garbage collection delegates when measuring.
+	FDelegateHandle PreGarbageCollectHandle;
+	FDelegateHandle PostGarbageCollectHandle;
+};
@@ -0,0 +1,92 @@
+/**
+*
+* Combat affinity matrix for vehicles.
+*
+* Original author: Rob Baker.
+* Current maintainer: Rob Baker.
+*
+* Copyright Caged Element Inc, code provided for educational purposes only.
+*
+* Whether one vehicle should fight another, and whether that other vehicle can be
+* attacked at all, is asked for every launcher and target pair during pickup
+* target selection and efficacy weighting. None of it changes during the vehicle
+* ticks that ask for it, so it's computed once per frame, after the race
+* positions have been updated, and stored flat, indexed by vehicle index.
+*
+***********************************************************************************/
+
+#pragma once
+
+#include "system/gameconfiguration.h"
+
+/**
+* The combat state of a vehicle, as seen by other vehicles targeting it.
+***********************************************************************************/
+
+struct FVehicleCombatFlags
+{
+	// Can AI vehicles attack this vehicle?
+	bool CanBeAttacked = true;
+
+	// Is the vehicle good for a smacking right now?
+	bool IsGoodForSmacking = true;
+
+	// Is the vehicle being driven by an AI bot?
+	bool HasAIDriver = false;
+
+	// Is the vehicle an AI bot vehicle, regardless of who's driving it right now?
+	bool IsAIVehicle = false;
+};
+
+/**
+* Combat affinity matrix for vehicles.
+***********************************************************************************/
+
+class FCombatAffinityMatrix
+{
+public:
+
+	// Reset the matrix for a number of vehicle indices, zeroing all of it.
+	void Reset(int32 numVehicles)
+	{ NumVehicles = numVehicles; Affinities.Reset(); Affinities.AddZeroed(numVehicles * (numVehicles + 1)); Flags.Reset(); Flags.AddDefaulted(numVehicles); }
+
+	// Is a vehicle index covered by the matrix?
+	bool IsValidIndex(int32 vehicleIndex) const
+	{ return vehicleIndex >= 0 && vehicleIndex < NumVehicles; }
+
+	// Get the number of vehicle indices covered by the matrix.
+	int32 Num() const
+	{ return NumVehicles; }
+
+	// Get how much an aggressor should fight a victim, or fight in general if victimIndex is INDEX_NONE.
+	float GetAffinity(int32 aggressorIndex, int32 victimIndex) const
+	{ return Affinities[GetAffinityIndex(aggressorIndex, victimIndex)]; }
+
+	// Set how much an aggressor should fight a victim, or fight in general if victimIndex is INDEX_NONE.
+	void SetAffinity(int32 aggressorIndex, int32 victimIndex, float affinity)
+	{ Affinities[GetAffinityIndex(aggressorIndex, victimIndex)] = affinity; }
+
+	// Get the combat flags for a vehicle.
+	const FVehicleCombatFlags& GetFlags(int32 vehicleIndex) const
+	{ return Flags[vehicleIndex]; }
+
+	// Set the combat flags for a vehicle.
+	void SetFlags(int32 vehicleIndex, const FVehicleCombatFlags& flags)
+	{ Flags[vehicleIndex] = flags; }
+
+private:
+
+	// Get the index into Affinities for an aggressor and victim pair, with the general
+	// affinity of each aggressor stored in the last column of its row.
+	int32 GetAffinityIndex(int32 aggressorIndex, int32 victimIndex) const
+	{ checkSlow(IsValidIndex(aggressorIndex) == true && (victimIndex == INDEX_NONE || IsValidIndex(victimIndex) == true)); return aggressorIndex * (NumVehicles + 1) + ((victimIndex == INDEX_NONE) ? NumVehicles : victimIndex); }
+
+	// The number of vehicle indices covered by the matrix.
+	int32 NumVehicles = 0;
+
+	// The affinities for each aggressor and victim pair, a row per aggressor.
+	TArray<float> Affinities;
+
+	// The combat flags for each vehicle.
+	TArray<FVehicleCombatFlags> Flags;
+};
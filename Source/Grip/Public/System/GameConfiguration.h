@@ -32,6 +32,8 @@ DECLARE_LOG_CATEGORY_EXTERN(GripTeleportationLog, Log, All);
 
 #define GRIP_ENGINE_EXTENDED_MODIFICATIONS 0					// These are extended engine changes which we've not made in this course to keep things simple
 #define GRIP_DEBUG_HOMING_MISSILE 0								// Debug diagnostics for the homing missile
+#define GRIP_DEBUG_VEHICLE_FORCE_ACCUMULATION 0					// Debug diagnostics to check accumulated vehicle forces against applying them individually
+#define GRIP_DEBUG_TIMED_VALUE_LISTS 0							// Debug diagnostics to check timed value list window statistics against scanning the values
 #define GRIP_USE_STEAM 1										// Should this build include Steam integration?
 #define GRIP_HAS_ONLINE_SUBSYSTEM 1								// Does this build feature an online subsystem?
 #define GRIP_GENERIC_PLAYER_NAME !GRIP_HAS_ONLINE_SUBSYSTEM		// Use generic names for players
@@ -39,6 +41,7 @@ DECLARE_LOG_CATEGORY_EXTERN(GripTeleportationLog, Log, All);
 #define GRIP_VEHICLE_SUSPENSION_BOUNCE_MITIGATION 1				// Try to soften the vehicle's natural tendency to bounce upon landings due to suspension response
 #define GRIP_VEHICLE_SUSPENSION_BOUNCE_NORMALIZE 1				// Try to normalize the vehicle's suspension bounce upon landings
 #define GRIP_VEHICLE_BOUNCE_CONTROL 1							// Directly control hard landings to kill natural bounce and replace it with controlled, forced bounce
+#define GRIP_VEHICLE_FORCE_ACCUMULATION 1						// Accumulate the forces applied to a vehicle over a physics sub-step and apply them to its physics body in one go
 #define GRIP_MANAGE_MAX_ANGULAR_VELOCITY 1						// Manage the maximum angular velocity of the vehicle
 #define GRIP_ANTI_SKYWARD_LAUNCH 1								// Work to prevent skyward launches due to collisions
 #define GRIP_NORMALIZED_WEIGHT_ON_WHEEL 1						// Try to prevent the tire grip from acting asymmetrically
@@ -46,6 +49,7 @@ DECLARE_LOG_CATEGORY_EXTERN(GripTeleportationLog, Log, All);
 #define GRIP_STATIC_ACCELERATION 0								// Flatten out the gear acceleration between different engine powers - now unwanted hack
 #define GRIP_VEHICLE_AUTO_TUNNEL_STEERING 1						// Avoid the tumble dryer effect when steering in tunnels
 #define GRIP_MAX_PLAYERS 10										// The maximum number of players in an event
+#define GRIP_MAX_BENCHMARK_PLAYERS 64							// The maximum number of players in a grid benchmark, beyond the limit for a normal event
 #define GRIP_MAX_LOCAL_PLAYERS 4								// The maximum number of local players in an event
 #define GRIP_STEERING_ACTIVE 0.1f								// The amount of steering that needs to be applied before it's considered active
 #define GRIP_STEERING_PURPOSEFUL 0.333f							// The amount of steering that needs to be applied before it's considered purposeful
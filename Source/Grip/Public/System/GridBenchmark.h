@@ -0,0 +1,93 @@
+/**
+*
+* Grid benchmark.
+*
+* Original author: Rob Baker.
+* Current maintainer: Rob Baker.
+*
+* Copyright Caged Element Inc, code provided for educational purposes only.
+*
+* A benchmark for measuring how the game scales with the size of the grid, well
+* beyond the number of players in a normal event. Run any track map with the
+* command line option -GripBenchmark=N, and the game mode will fill the grid with
+* N bots, replicating the start line backwards if the map doesn't have enough
+* player starts. Once the race has been running for a little while, the game
+* thread and vehicle physics times are sampled for a period and then reported to
+* the log and appended to Saved/Profiling/GripBenchmark.csv. Add -GripBenchmarkExit
+* to quit once reported, and -nullrhi -nosound -unattended to run it headless, so
+* a script can run it for increasing N.
+*
+***********************************************************************************/
+
+#pragma once
+
+#include "system/gameconfiguration.h"
+
+/**
+* Benchmark for measuring the scaling of the game with the size of the grid.
+***********************************************************************************/
+
+class FGridBenchmark
+{
+public:
+
+	// Get the number of vehicles requested for the benchmark, or 0 if not benchmarking.
+	static int32 GetNumVehicles();
+
+	// Is the benchmark active?
+	static bool IsActive()
+	{ return GetNumVehicles() > 0; }
+
+	// Tick the benchmark, sampling the thread times once the race is in play.
+	void Tick(int32 numVehicles, bool inPlay);
+
+	// Timer for a vehicle physics sub-step, which may be on any thread.
+	struct FScopedPhysicsTimer
+	{
+		FScopedPhysicsTimer()
+			: StartCycles((Sampling == true) ? FPlatformTime::Cycles() : 0)
+		{ }
+
+		~FScopedPhysicsTimer()
+		{ if (StartCycles != 0) PhysicsCycles.Add(FPlatformTime::Cycles() - StartCycles); }
+
+	private:
+
+		// The cycle counter when the timer started, or 0 if not sampling.
+		uint32 StartCycles = 0;
+	};
+
+private:
+
+	// Report the results of the benchmark.
+	void Report(int32 numVehicles) const;
+
+	// The time in seconds to let the race settle before sampling.
+	static const float WarmupTime;
+
+	// The time in seconds to sample for.
+	static const float SampleTime;
+
+	// Is the benchmark currently sampling the vehicle physics?
+	static bool Sampling;
+
+	// The cycles spent in vehicle physics sub-steps since the last tick.
+	static FThreadSafeCounter PhysicsCycles;
+
+	// The time in play so far.
+	float Timer = 0.0f;
+
+	// The number of frames sampled.
+	int32 NumFrames = 0;
+
+	// The total frame, game thread and vehicle physics times sampled, in milliseconds.
+	double FrameTime = 0.0;
+	double GameThreadTime = 0.0;
+	double PhysicsTime = 0.0;
+
+	// The worst game thread time sampled, in milliseconds.
+	double MaxGameThreadTime = 0.0;
+
+	// Have the results been reported?
+	bool Reported = false;
+};
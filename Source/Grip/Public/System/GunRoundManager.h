@@ -0,0 +1,91 @@
+/**
+*
+* Gun round manager.
+*
+* Original author: Rob Baker.
+* Current maintainer: Rob Baker.
+*
+* Copyright Caged Element Inc, code provided for educational purposes only.
+*
+* Gatling guns fire up to 30 rounds a second each, and with a grid full of them
+* firing at once each round doing its own synchronous line trace on the game
+* thread adds up quickly. Instead, all of the live rounds from all of the guns
+* are held here, in parallel arrays, and their traces are issued asynchronously
+* so the engine can run them together as a batch. The results are collected on
+* the next frame and handed back to the guns that fired them to apply.
+*
+***********************************************************************************/
+
+#pragma once
+
+#include "system/gameconfiguration.h"
+
+class AGatlingGun;
+
+DECLARE_STATS_GROUP(TEXT("GRIP Gun Rounds"), STATGROUP_GripGunRounds, STATCAT_Advanced);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Gun Rounds Tick"), STAT_GunRoundsTick, STATGROUP_GripGunRounds, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Gun Rounds Fired"), STAT_GunRoundsFired, STATGROUP_GripGunRounds, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Gun Rounds Hit"), STAT_GunRoundsHit, STATGROUP_GripGunRounds, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Gun Rounds In Flight"), STAT_GunRoundsInFlight, STATGROUP_GripGunRounds, );
+
+/**
+* Manager for all of the live gun rounds in the game.
+***********************************************************************************/
+
+class FGunRoundManager
+{
+public:
+
+	// Construct the manager.
+	FGunRoundManager();
+
+	// Fire a round from a gun, its hit being applied when the trace for it completes.
+	void FireRound(AGatlingGun* gun, const FVector& start, const FVector& end, AActor* target, AActor* ignoreTarget);
+
+	// Apply the hits of all of the rounds fired by a gun right away, normally because
+	// it's being put away and the hits would otherwise be applied to its next use.
+	void FlushRounds(AGatlingGun* gun);
+
+	// Tick the manager, collecting the results of the traces for rounds and applying
+	// their hits.
+	void Tick();
+
+	// Get the number of rounds whose traces are currently in flight.
+	int32 GetNumRounds() const
+	{ return Handles.Num(); }
+
+private:
+
+	// Setup the query parameters for tracing a round fired from a gun.
+	void SetupQueryParams(AGatlingGun* gun, AActor* ignoreTarget);
+
+	// Apply the hit of a round, if it hit anything.
+	void ApplyRound(int32 index, AGatlingGun* gun, const FHitResult& hitResult);
+
+	// Remove a round from the manager.
+	void RemoveRound(int32 index);
+
+	// The world that the rounds are traced within.
+	UWorld* World = nullptr;
+
+	// The query parameters used for the traces, reused between rounds.
+	FCollisionQueryParams QueryParams;
+
+	// The trace handles for the rounds.
+	TArray<FTraceHandle> Handles;
+
+	// The guns that fired the rounds.
+	TArray<TWeakObjectPtr<AGatlingGun>> Guns;
+
+	// The targets that the rounds were aimed at, if any.
+	TArray<TWeakObjectPtr<AActor>> Targets;
+
+	// The targets that the rounds were told to miss, if any.
+	TArray<TWeakObjectPtr<AActor>> IgnoreTargets;
+
+	// The start locations of the rounds.
+	TArray<FVector> Starts;
+
+	// The end locations of the rounds.
+	TArray<FVector> Ends;
+};
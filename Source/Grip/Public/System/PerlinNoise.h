@@ -9,6 +9,11 @@
 *
 * An implementation of the Perlin noise technique, over 1, 2 or 3 dimensions.
 *
+* Noise can also be evaluated in batches, where the table lookups are done for
+* each coordinate but the remaining arithmetic is done for four coordinates at a
+* time using vector instructions, in exactly the same order as the single
+* coordinate versions so the results are identical.
+*
 ***********************************************************************************/
 
 #pragma once
@@ -39,12 +44,45 @@ public:
 	// Get some three dimensional noise.
 	float Noise3(float x, float y, float z) const;
 
+	// Get some one dimensional noise for a batch of coordinates.
+	void Noise1(const float* x, float* results, int32 count) const;
+
+	// Get some two dimensional noise for a batch of coordinates.
+	void Noise2(const float* x, const float* y, float* results, int32 count) const;
+
+	// Get some three dimensional noise for a batch of coordinates.
+	void Noise3(const float* x, const float* y, const float* z, float* results, int32 count) const;
+
+	// Get four octaves of one dimensional noise summed together, each octave double
+	// the frequency and half the amplitude of the last.
+	float OctaveNoise1(float x) const;
+
+	// The number of coordinates processed together in each vector operation.
+	static const int32 VectorWidth = 4;
+
 	// Get the random number generator used for creating noise.
 	FMathEx::FRandomFast& GetRandom()
 	{ return Random; }
 
 private:
 
+	// Get some one dimensional noise for four coordinates at once.
+	void Noise1x4(const float* x, float* results) const;
+
+	// Get some two dimensional noise for four coordinates at once.
+	void Noise2x4(const float* x, const float* y, float* results) const;
+
+	// Get some three dimensional noise for four coordinates at once.
+	void Noise3x4(const float* x, const float* y, const float* z, float* results) const;
+
+	// Floor four coordinates into integers and a vector register, in the same way as the single coordinate versions.
+	static VectorRegister Floor(const float* values, int32* floors)
+	{ for (int32 i = 0; i < VectorWidth; i++) floors[i] = FMath::FloorToInt(values[i]); return MakeVectorRegister((float)floors[0], (float)floors[1], (float)floors[2], (float)floors[3]); }
+
+	// Gather four values from a table into a vector register.
+	static VectorRegister Gather(const float* table, const int32* indices)
+	{ return MakeVectorRegister(table[indices[0]], table[indices[1]], table[indices[2]], table[indices[3]]); }
+
 	static const int32 SIZE = 256;
 	static const int32 MASK = SIZE - 1;
 
@@ -0,0 +1,48 @@
+/**
+*
+* Poolable interface.
+*
+* Original author: Rob Baker.
+* Current maintainer: Rob Baker.
+*
+* Copyright Caged Element Inc, code provided for educational purposes only.
+*
+* An interface to use for actors that can be recycled through the actor pool
+* rather than being spawned and destroyed each time they're used.
+*
+***********************************************************************************/
+
+#pragma once
+
+#include "system/gameconfiguration.h"
+#include "poolable.generated.h"
+
+/**
+* Boilerplate class for the PoolableInterface.
+***********************************************************************************/
+
+UINTERFACE(MinimalAPI, meta = (CannotImplementInterfaceInBlueprint))
+class UPoolableInterface : public UInterface
+{
+	GENERATED_UINTERFACE_BODY()
+};
+
+/**
+* Interface class for the PoolableInterface.
+***********************************************************************************/
+
+class IPoolableInterface
+{
+	GENERATED_IINTERFACE_BODY()
+
+public:
+
+	// Called when the actor is taken from the pool, before it's used again. The pool
+	// has already moved it into place, unhidden it and re-enabled its ticking.
+	virtual void OnAcquiredFromPool()
+	{ }
+
+	// Called when the actor is returned to the pool, to reset it to the state it was
+	// in when it was first spawned. The pool hides it and disables its ticking.
+	virtual void OnReleasedToPool() = 0;
+};
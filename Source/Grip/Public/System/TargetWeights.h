@@ -0,0 +1,70 @@
+/**
+*
+* Batched target weighting.
+*
+* Original author: Rob Baker.
+* Current maintainer: Rob Baker.
+*
+* Copyright Caged Element Inc, code provided for educational purposes only.
+*
+* Target selection for the offensive pickups weighs every candidate vehicle with
+* FMathEx::TargetWeight, each of which takes a square root, a normalization and an
+* arc cosine. Most candidates are out of range or outside of the cone though, so
+* here the candidate positions are held in structure-of-arrays form and culled by
+* range and cone four at a time using vector instructions, comparing squared
+* quantities so that no square roots are needed. Only the survivors go on to have
+* their weight calculated, in exactly the same way as TargetWeight.
+*
+***********************************************************************************/
+
+#pragma once
+
+#include "system/gameconfiguration.h"
+
+/**
+* Batched weighting of candidate target positions.
+***********************************************************************************/
+
+class FTargetWeights
+{
+public:
+
+	// The number of candidates processed together in each vector operation.
+	static const int32 VectorWidth = 4;
+
+	// Remove all of the candidates.
+	void Reset()
+	{ X.Reset(); Y.Reset(); Z.Reset(); Weights.Reset(); }
+
+	// Add a candidate target position, returning its index.
+	int32 Add(const FVector& position)
+	{ X.Emplace(position.X); Y.Emplace(position.Y); Z.Emplace(position.Z); return Weights.Emplace(-1.0f); }
+
+	// Get the number of candidates.
+	int32 Num() const
+	{ return Weights.Num(); }
+
+	// Compute the weights of all of the candidates, with the same parameters and
+	// results as FMathEx::TargetWeight.
+	void Compute(const FVector& fromPosition, const FVector& fromDirection, float minDistance, float maxDistance, float maxCosAngle, bool weightAngle);
+
+	// Get the weight of a candidate, between 0 and 1 with 0 being perfect, or -1 if invalid.
+	float GetWeight(int32 index) const
+	{ return Weights[index]; }
+
+	// Get the position of a candidate.
+	FVector GetPosition(int32 index) const
+	{ return FVector(X[index], Y[index], Z[index]); }
+
+private:
+
+	typedef TArray<float, TInlineAllocator<16>> FFloatList;
+
+	// The candidate positions.
+	FFloatList X;
+	FFloatList Y;
+	FFloatList Z;
+
+	// The computed weights for the candidates.
+	FFloatList Weights;
+};
@@ -0,0 +1,78 @@
+/**
+*
+* Fleet-wide registry of incoming threats.
+*
+* Original author: Rob Baker.
+* Current maintainer: Rob Baker.
+*
+* Copyright Caged Element Inc, code provided for educational purposes only.
+*
+* The AI bots, the HUD warnings and the cinematic cameras all want to know which
+* missiles are incoming on which vehicles, and how soon they'll hit. Rather than
+* each of them scanning all of the missiles in the game and estimating the time
+* to impact for themselves, the registry does this once per frame and keeps, for
+* each target vehicle, a small list of its incoming threats sorted by time to
+* impact.
+*
+***********************************************************************************/
+
+#pragma once
+
+#include "system/gameconfiguration.h"
+
+class AHomingMissile;
+
+/**
+* A threat incoming on a target vehicle.
+***********************************************************************************/
+
+struct FIncomingThreat
+{
+	// The missile that is incoming.
+	TWeakObjectPtr<AHomingMissile> Missile;
+
+	// The estimated time to impact, in seconds.
+	float TimeToTarget = 0.0f;
+
+	// The distance from the missile to the target, in centimeters.
+	float Distance = 0.0f;
+
+	// Is the missile currently homing?
+	bool Homing = false;
+
+	// Does the missile still have a lock on the target?
+	bool Locked = false;
+
+	// Is the missile likely to hit the target?
+	bool LikelyToHit = false;
+
+	// Is the target within reach of the missile?
+	bool WithinReach = false;
+};
+
+/**
+* Fleet-wide registry of incoming threats.
+***********************************************************************************/
+
+class FThreatRegistry
+{
+public:
+
+	// A list of incoming threats, sorted by time to impact, soonest first.
+	typedef TArray<FIncomingThreat, TInlineAllocator<4>> FThreatList;
+
+	// Update the registry from the missiles currently present in the game.
+	void Update(const TArray<AHomingMissile*>& missiles);
+
+	// Get the threats incoming on a vehicle, sorted by time to impact, soonest first.
+	const FThreatList& GetIncoming(int32 vehicleIndex) const
+	{ return (Threats.IsValidIndex(vehicleIndex) == true) ? Threats[vehicleIndex] : NoThreats; }
+
+private:
+
+	// The threats incoming on each vehicle, indexed by vehicle index.
+	TArray<FThreatList> Threats;
+
+	// An empty list of threats, for vehicles that don't have any.
+	static const FThreatList NoThreats;
+};
@@ -24,15 +24,114 @@
 * the mean value, or the sum, that kind of thing. This is great for examining a
 * property over time, rather than instantaneously at the current time.
 *
+* Lists whose capacity is known up front can be declared as TFixedTimedValueList,
+* holding their values inline rather than on the heap.
+*
+* Normally these queries scan the values in the list. For lists that are queried
+* over their whole window very often, window statistics can be requested, where
+* running sums and monotonic queues of the minimum and maximum values are kept up
+* to date as values are added and removed, so that those queries are O(1).
+*
 ***********************************************************************************/
 
 #pragma once
 
 #include "system/mathhelpers.h"
 
+#if GRIP_DEBUG_TIMED_VALUE_LISTS
+#define GRIP_CHECK_WINDOW_VALUE(value, scanned) ensure(TTimedValueTraits<ValueType>::IsNearlyEqual(value, scanned, TTimedValueTraits<ValueType>::Magnitude(SumLow) + TTimedValueTraits<ValueType>::Magnitude(SumHigh)))
+#else // GRIP_DEBUG_TIMED_VALUE_LISTS
+#define GRIP_CHECK_WINDOW_VALUE(value, scanned)
+#endif // GRIP_DEBUG_TIMED_VALUE_LISTS
+
+/**
+* Traits for the types of value held in a timed value list, the general case
+* having no ordering and so no minimum or maximum values to track.
+***********************************************************************************/
+
 template<typename ValueType>
+struct TTimedValueTraits
+{
+	// Can values of this type be ordered?
+	static const bool Ordered = false;
+
+	// Is one value less than another?
+	static bool Less(const ValueType& a, const ValueType& b)
+	{ return false; }
+
+	// Is a value negative?
+	static bool IsNegative(const ValueType& value)
+	{ return false; }
+
+	// Get the magnitude of a value.
+	static float Magnitude(const ValueType& value)
+	{ return value.GetAbsMax(); }
+
+	// Are two values nearly equal, allowing for the rounding of running sums of a
+	// given magnitude?
+	static bool IsNearlyEqual(const ValueType& a, const ValueType& b, float magnitude)
+	{ return a.Equals(b, FMath::Max(1.0f, magnitude) * 1.0e-4f); }
+};
+
+/**
+* Traits for the float type held in a timed value list.
+***********************************************************************************/
+
+template<>
+struct TTimedValueTraits<float>
+{
+	// Can values of this type be ordered?
+	static const bool Ordered = true;
+
+	// Is one value less than another?
+	static bool Less(float a, float b)
+	{ return a < b; }
+
+	// Is a value negative?
+	static bool IsNegative(float value)
+	{ return value < 0.0f; }
+
+	// Get the magnitude of a value.
+	static float Magnitude(float value)
+	{ return FMath::Abs(value); }
+
+	// Are two values nearly equal, allowing for the rounding of running sums of a
+	// given magnitude?
+	static bool IsNearlyEqual(float a, float b, float magnitude)
+	{ return FMath::IsNearlyEqual(a, b, FMath::Max(1.0f, magnitude) * 1.0e-4f); }
+};
+
+/**
+* The allocator for the values of a timed value list with a fixed capacity, held
+* inline.
+***********************************************************************************/
+
+template<int32 Capacity>
+struct TTimedValueAllocator
+{
+	typedef TFixedAllocator<Capacity> Type;
+};
+
+/**
+* The allocator for the values of a timed value list with no fixed capacity, held
+* on the heap.
+***********************************************************************************/
+
+template<>
+struct TTimedValueAllocator<0>
+{
+	typedef FDefaultAllocator Type;
+};
+
+/**
+* A list of values against time, with its values on the heap if Capacity is 0.
+***********************************************************************************/
+
+template<typename ValueType, int32 Capacity = 0>
 class GRIP_API TTimedValueList
 {
+	static_assert((Capacity & (Capacity - 1)) == 0, "The capacity of a timed value list must be a power of two");
+
 public:
 
 	struct FTimeValue
@@ -50,18 +149,14 @@ public:
 	};
 
 	// Construct a timed valued list.
-	TTimedValueList(int32 maxSeconds = 1, int32 samplesPerSecond = 60, bool averageSamples = true, bool sumSamples = false)
-	{ Reset(maxSeconds, samplesPerSecond, averageSamples, sumSamples); }
-
-	// Construct a timed valued list from another list.
-	TTimedValueList(const TTimedValueList& other)
-	{ *this = other; }
-
-	~TTimedValueList()
-	{ if (Values != nullptr) delete Values; Values = nullptr; }
+	TTimedValueList(int32 maxSeconds = 1, int32 samplesPerSecond = 60, bool averageSamples = true, bool sumSamples = false, bool windowStatistics = false)
+	{ Reset(maxSeconds, samplesPerSecond, averageSamples, sumSamples, windowStatistics); }
 
 	// Reset a timed valued list, effectively constructing it.
-	void Reset(int32 maxSeconds = 1, int32 samplesPerSecond = 60, bool averageSamples = true, bool sumSamples = false)
+	// windowStatistics keeps running statistics for the whole window of values so that
+	// queries over all of it are O(1), at the cost of a little more work when adding
+	// values and some extra memory.
+	void Reset(int32 maxSeconds = 1, int32 samplesPerSecond = 60, bool averageSamples = true, bool sumSamples = false, bool windowStatistics = false)
 	{
 		MaxSeconds = maxSeconds;
 		MaxValues = maxSeconds * ((samplesPerSecond > 0) ? samplesPerSecond : 1000);
@@ -77,14 +172,28 @@ public:
 		NumSumValues = 0;
 		AverageSamples = averageSamples;
 		SumSamples = sumSamples;
+		WindowStatistics = windowStatistics;
 		Full = false;
 
-		if (Values != nullptr)
+		checkf(Capacity == 0 || IndexMask <= Capacity, TEXT("Timed value list capacity %d is too small for %d values"), Capacity, MaxValues);
+
+		Values.Init(FTimeValue(), IndexMask);
+
+		if (WindowStatistics == true &&
+			TTimedValueTraits<ValueType>::Ordered == true)
+		{
+			MinQueue.Init(0, IndexMask);
+			MaxQueue.Init(0, IndexMask);
+		}
+		else
 		{
-			delete Values;
+			MinQueue.Empty();
+			MaxQueue.Empty();
 		}
 
-		Values = new FTimeValue[IndexMask--];
+		IndexMask--;
+
+		ClearWindowStatistics();
 	}
 
 	// Add a value to the value list.
@@ -110,10 +219,10 @@ public:
 			{
 				if (SecondsPerSample > 0)
 				{
-					if (NumValues >= MaxValues)
+					while (NumValues >= MaxValues)
 					{
 						Full = true;
-						NumValues = MaxValues - 1;
+						RemoveOldestValue();
 					}
 				}
 				else
@@ -122,27 +231,35 @@ public:
 						time - (*this)[0].Time > MaxSeconds)
 					{
 						Full = true;
-						NumValues--;
-						SetReadCursor();
+						RemoveOldestValue();
 					}
 				}
 
 				NumValues++;
+				NumAdded++;
 				WriteCursor = (WriteCursor + 1) & IndexMask;
 				SetReadCursor();
 
 				if (SumSamples == true)
 				{
-					Values[WriteCursor] = FTimeValue(time, SumValues);
+					Values.GetData()[WriteCursor] = FTimeValue(time, SumValues);
 				}
 				else if (AverageSamples == true &&
 					NumSumValues > 0)
 				{
-					Values[WriteCursor] = FTimeValue(SumStart, SumValues * (1.0f / NumSumValues));
+					// Without a sample rate, SumStart doesn't track the time of the values
+					// and so the time given is used instead, keeping the times in order.
+
+					Values.GetData()[WriteCursor] = FTimeValue((SecondsPerSample > 0) ? SumStart : time, SumValues * (1.0f / NumSumValues));
 				}
 				else
 				{
-					Values[WriteCursor] = FTimeValue(time, value);
+					Values.GetData()[WriteCursor] = FTimeValue(time, value);
+				}
+
+				if (WindowStatistics == true)
+				{
+					AddWindowValue();
 				}
 
 				SumValues = ValueType(0.0f);
@@ -163,6 +280,439 @@ public:
 
 	// Get the minimum value of all the values in the list.
 	ValueType GetMinValue(float since = -1.0f) const
+	{
+		if (IsOrderedWindowQuery(since) == true)
+		{
+			ValueType min = GetSequencedValue(MinQueue.GetData()[MinHead]);
+
+			GRIP_CHECK_WINDOW_VALUE(min, ScanMinValue(since));
+
+			return min;
+		}
+
+		return ScanMinValue(since);
+	}
+
+	// Get the maximum value of all the values in the list.
+	ValueType GetMaxValue(float since = -1.0f) const
+	{
+		if (IsOrderedWindowQuery(since) == true)
+		{
+			ValueType max = GetSequencedValue(MaxQueue.GetData()[MaxHead]);
+
+			GRIP_CHECK_WINDOW_VALUE(max, ScanMaxValue(since));
+
+			return max;
+		}
+
+		return ScanMaxValue(since);
+	}
+
+	// Get the mean average value of all the values in the list.
+	ValueType GetMeanValue(float since = -1.0f) const
+	{
+		if (IsWindowQuery(since) == true)
+		{
+			ValueType mean = (SumLow + SumHigh) / NumValues;
+
+			GRIP_CHECK_WINDOW_VALUE(mean, ScanMeanValue(since));
+
+			return mean;
+		}
+
+		return ScanMeanValue(since);
+	}
+
+	// Get the unfluttered value of all the values in the list.
+	// This attempts to remove any hysteresis recorded in the values in the list and smooth out the result.
+	ValueType GetUnflutteredValue(float since = -1.0f, bool higher = false) const
+	{
+		if (IsOrderedWindowQuery(since) == true)
+		{
+			int32 numHigh = NumValues - NumLow;
+			ValueType meanLow = (NumLow > 0) ? SumLow / NumLow : ValueType(0.0f);
+			ValueType meanHigh = (numHigh > 0) ? SumHigh / numHigh : ValueType(0.0f);
+			ValueType unfluttered = (NumSwitches == 0) ? meanHigh + meanLow : ((higher == true) ? meanHigh : meanLow);
+
+			GRIP_CHECK_WINDOW_VALUE(unfluttered, ScanUnflutteredValue(since, higher));
+
+			return unfluttered;
+		}
+
+		return ScanUnflutteredValue(since, higher);
+	}
+
+	// Get the mean average value of all the values in the list.
+	ValueType GetAbsMeanValue(float since = -1.0f) const
+	{
+		if (IsOrderedWindowQuery(since) == true)
+		{
+			ValueType mean = (SumHigh - SumLow) / NumValues;
+
+			GRIP_CHECK_WINDOW_VALUE(mean, ScanAbsMeanValue(since));
+
+			return mean;
+		}
+
+		return ScanAbsMeanValue(since);
+	}
+
+	// Get the mean average value of all the values in the list scaled by the number of
+	// values recorded in the list vs its maximum size.
+	ValueType GetScaledMeanValue() const
+	{
+		if (IsWindowQuery(-1.0f) == true &&
+			MaxValues > 0)
+		{
+			ValueType mean = ((SumLow + SumHigh) / NumValues) * (float)NumValues / (float)MaxValues;
+
+			GRIP_CHECK_WINDOW_VALUE(mean, ScanScaledMeanValue());
+
+			return mean;
+		}
+
+		return ScanScaledMeanValue();
+	}
+
+	// Get the mean average value of all the values in the list scaled by the number of
+	// values recorded in the list vs its maximum size.
+	ValueType GetAbsScaledMeanValue() const
+	{
+		if (IsOrderedWindowQuery(-1.0f) == true &&
+			MaxValues > 0)
+		{
+			ValueType mean = (SumHigh - SumLow) / NumValues * (float)NumValues / (float)MaxValues;
+
+			GRIP_CHECK_WINDOW_VALUE(mean, ScanAbsScaledMeanValue());
+
+			return mean;
+		}
+
+		return ScanAbsScaledMeanValue();
+	}
+
+	// Get the sum value of all the values in the list.
+	ValueType GetSumValue(float since = -1.0f) const
+	{
+		if (IsWindowQuery(since) == true)
+		{
+			ValueType sum = SumLow + SumHigh;
+
+			GRIP_CHECK_WINDOW_VALUE(sum, ScanSumValue(since));
+
+			return sum;
+		}
+
+		return ScanSumValue(since);
+	}
+
+	// Get the sum value of all the values in the list.
+	ValueType GetAbsSumValue(float since = -1.0f) const
+	{
+		if (IsOrderedWindowQuery(since) == true)
+		{
+			ValueType sum = SumHigh - SumLow;
+
+			GRIP_CHECK_WINDOW_VALUE(sum, ScanAbsSumValue(since));
+
+			return sum;
+		}
+
+		return ScanAbsSumValue(since);
+	}
+
+	// Get the value at a particular time in the list.
+	ValueType GetValueAt(float at) const
+	{
+		int32 i = NumValues - 1;
+
+		for (; i > 0; i--)
+		{
+			const FTimeValue& element = (*this)[i];
+
+			if (element.Time < at)
+			{
+				i++;
+				break;
+			}
+		}
+
+		return (i < NumValues) ? (*this)[i].Value : ValueType(0.0f);
+	}
+
+	// Get the difference between the value given and the value stored at at, and divide that
+	// by the time difference between the clock given and time stored at at, thus the change
+	// in the values that would occur over one second of time, regardless of how much time
+	// we're examining.
+	ValueType DifferenceFromPerSecond(float at, float clock, float value) const
+	{
+		int32 i = NumValues - 1;
+
+		for (; i > 0; i--)
+		{
+			const FTimeValue& element = (*this)[i];
+
+			if (element.Time < at)
+			{
+				i++;
+				break;
+			}
+		}
+
+		for (; i < NumValues; i++)
+		{
+			const FTimeValue& element = (*this)[i];
+
+			if (element.Time >= at)
+			{
+				float timeDifference = (clock - element.Time);
+
+				if (timeDifference > KINDA_SMALL_NUMBER)
+				{
+					return (value - element.Value) / timeDifference;
+				}
+				else
+				{
+					return value - element.Value;
+				}
+			}
+		}
+
+		float timeDifference = (clock - LastTime);
+
+		if (timeDifference > KINDA_SMALL_NUMBER)
+		{
+			return (value - LastValue) / timeDifference;
+		}
+		else
+		{
+			return value - LastValue;
+		}
+	}
+
+	// Get the time range of the values in the list.
+	float TimeRange() const
+	{
+		if (NumValues > 0)
+		{
+			return (*this)[NumValues - 1].Time - (*this)[0].Time;
+		}
+		else
+		{
+			return 0.0f;
+		}
+	}
+
+	// Clear the list of all recorded values.
+	void Clear()
+	{
+		Full = false;
+		NumValues = ReadCursor = WriteCursor = 0;
+
+		ClearWindowStatistics();
+	}
+
+	// Clear the list of all recorded values with a Time < time.
+	void Clear(float time)
+	{
+		while (NumValues > 0 &&
+			(*this)[0].Time < time)
+		{
+			Full = false;
+			RemoveOldestValue();
+		}
+
+		if (WindowStatistics == true)
+		{
+			CalculateWindowSums();
+		}
+	}
+
+	// Get the number of values in the list.
+	int32 GetNumValues() const
+	{ return NumValues; }
+
+	// Get the maximum number of values in the list.
+	int32 GetMaxValues() const
+	{ return MaxValues; }
+
+	// Is the list full? Meaning is it storing its maximum capacity of of values yet?
+	bool IsFull() const
+	{ return Full; }
+
+	// Note that index 0 is the oldest value in the list and _numValues - 1 is the most recent.
+	const FTimeValue& operator [] (int32 index) const
+	{ return Values.GetData()[(index + ReadCursor) & IndexMask]; }
+
+private:
+
+	// Set the read cursor for the list after adding or removing values.
+	void SetReadCursor()
+	{ if ((ReadCursor = WriteCursor - (NumValues - 1)) < 0) ReadCursor = (IndexMask + 1) + ReadCursor; }
+
+	// Remove the oldest value from the list.
+	void RemoveOldestValue()
+	{
+		if (WindowStatistics == true)
+		{
+			RemoveWindowValue();
+		}
+
+		NumValues--;
+		SetReadCursor();
+	}
+
+	// Can a query of the values since a time be answered from the window statistics?
+	// This is the case when it would otherwise scan every value in the list.
+	bool IsWindowQuery(float since) const
+	{ return (WindowStatistics == true && NumValues > 0 && (since < 0.0f || since <= (*this)[0].Time)); }
+
+	// Can a query of the values since a time that relies on their ordering be answered
+	// from the window statistics?
+	bool IsOrderedWindowQuery(float since) const
+	{ return (TTimedValueTraits<ValueType>::Ordered == true && IsWindowQuery(since) == true); }
+
+	// Update the window statistics for the value that's just been written to the list.
+	void AddWindowValue()
+	{
+		typedef TTimedValueTraits<ValueType> Traits;
+
+		ValueType value = Values.GetData()[WriteCursor].Value;
+		bool negative = Traits::IsNegative(value);
+
+		if (negative == true)
+		{
+			SumLow += value;
+			NumLow++;
+		}
+		else
+		{
+			SumHigh += value;
+		}
+
+		if (NumValues > 1 &&
+			Traits::IsNegative((*this)[NumValues - 2].Value) != negative)
+		{
+			NumSwitches++;
+		}
+
+		if (MinQueue.Num() > 0)
+		{
+			uint32* minQueue = MinQueue.GetData();
+			uint32* maxQueue = MaxQueue.GetData();
+
+			// Values in the queues that can never be the minimum or maximum again, because
+			// this newer value is at least as small or large, are dropped from the back.
+
+			while (MinCount > 0 &&
+				Traits::Less(GetSequencedValue(minQueue[(MinHead + MinCount - 1) & IndexMask]), value) == false)
+			{
+				MinCount--;
+			}
+
+			minQueue[(MinHead + MinCount++) & IndexMask] = NumAdded;
+
+			while (MaxCount > 0 &&
+				Traits::Less(value, GetSequencedValue(maxQueue[(MaxHead + MaxCount - 1) & IndexMask])) == false)
+			{
+				MaxCount--;
+			}
+
+			maxQueue[(MaxHead + MaxCount++) & IndexMask] = NumAdded;
+		}
+
+		// Running sums accumulate rounding errors as values are added and removed, so
+		// calculate them from scratch each time we wrap around the buffer.
+
+		if ((NumAdded & IndexMask) == 0)
+		{
+			CalculateWindowSums();
+		}
+	}
+
+	// Update the window statistics for the oldest value that's about to be removed from the list.
+	void RemoveWindowValue()
+	{
+		typedef TTimedValueTraits<ValueType> Traits;
+
+		ValueType value = (*this)[0].Value;
+		bool negative = Traits::IsNegative(value);
+
+		// Snap the sums to zero when there are no values left in them, so any rounding
+		// errors from the values removed from them don't linger.
+
+		if (negative == true)
+		{
+			SumLow = (--NumLow == 0) ? ValueType(0.0f) : SumLow - value;
+		}
+		else
+		{
+			SumHigh = (NumValues - 1 == NumLow) ? ValueType(0.0f) : SumHigh - value;
+		}
+
+		if (NumValues > 1 &&
+			Traits::IsNegative((*this)[1].Value) != negative)
+		{
+			NumSwitches--;
+		}
+
+		if (MinQueue.Num() > 0)
+		{
+			// The oldest value can only be at the front of the queues.
+
+			uint32 oldest = NumAdded - (NumValues - 1);
+
+			if (MinCount > 0 &&
+				MinQueue.GetData()[MinHead] == oldest)
+			{
+				MinHead = (MinHead + 1) & IndexMask;
+				MinCount--;
+			}
+
+			if (MaxCount > 0 &&
+				MaxQueue.GetData()[MaxHead] == oldest)
+			{
+				MaxHead = (MaxHead + 1) & IndexMask;
+				MaxCount--;
+			}
+		}
+	}
+
+	// Calculate the window sums from scratch.
+	void CalculateWindowSums()
+	{
+		SumLow = SumHigh = ValueType(0.0f);
+
+		for (int32 i = 0; i < NumValues; i++)
+		{
+			ValueType value = (*this)[i].Value;
+
+			if (TTimedValueTraits<ValueType>::IsNegative(value) == true)
+			{
+				SumLow += value;
+			}
+			else
+			{
+				SumHigh += value;
+			}
+		}
+	}
+
+	// Clear the window statistics.
+	void ClearWindowStatistics()
+	{
+		NumAdded = 0;
+		SumLow = SumHigh = ValueType(0.0f);
+		NumLow = NumSwitches = 0;
+		MinHead = MinCount = MaxHead = MaxCount = 0;
+	}
+
+	// Get the value in the list with a given sequence number.
+	ValueType GetSequencedValue(uint32 sequence) const
+	{ return Values.GetData()[sequence & IndexMask].Value; }
+
+	// Scan the list for the minimum value of all the values in the list.
+	ValueType ScanMinValue(float since) const
 	{
 		ValueType min = ValueType(0.0f);
 
@@ -206,8 +756,8 @@ public:
 		return min;
 	}
 
-	// Get the maximum value of all the values in the list.
-	ValueType GetMaxValue(float since = -1.0f) const
+	// Scan the list for the maximum value of all the values in the list.
+	ValueType ScanMaxValue(float since) const
 	{
 		ValueType max = ValueType(0.0f);
 
@@ -251,8 +801,8 @@ public:
 		return max;
 	}
 
-	// Get the mean average value of all the values in the list.
-	ValueType GetMeanValue(float since = -1.0f) const
+	// Scan the list for the mean average value of all the values in the list.
+	ValueType ScanMeanValue(float since) const
 	{
 		ValueType sum = ValueType(0.0f);
 		int32 numSummed = 0;
@@ -285,9 +835,8 @@ public:
 		return (numSummed > 0) ? sum / numSummed : ValueType(0.0f);
 	}
 
-	// Get the unfluttered value of all the values in the list.
-	// This attempts to remove any hysteresis recorded in the values in the list and smooth out the result.
-	ValueType GetUnflutteredValue(float since = -1.0f, bool higher = false) const
+	// Scan the list for the unfluttered value of all the values in the list.
+	ValueType ScanUnflutteredValue(float since, bool higher) const
 	{
 		ValueType sumLow = ValueType(0.0f), sumHigh = ValueType(0.0f);
 		int32 numSummedLow = 0, numSummedHigh = 0, numSwitches = 0, switchPosition = -1;
@@ -343,8 +892,8 @@ public:
 		}
 	}
 
-	// Get the mean average value of all the values in the list.
-	ValueType GetAbsMeanValue(float since = -1.0f) const
+	// Scan the list for the mean average value of all the values in the list.
+	ValueType ScanAbsMeanValue(float since) const
 	{
 		ValueType sum = ValueType(0.0f);
 		int32 numSummed = 0;
@@ -377,9 +926,9 @@ public:
 		return (numSummed > 0) ? sum / numSummed : ValueType(0.0f);
 	}
 
-	// Get the mean average value of all the values in the list scaled by the number of
+	// Scan the list for the mean average value of all the values in the list scaled by the number of
 	// values recorded in the list vs its maximum size.
-	ValueType GetScaledMeanValue() const
+	ValueType ScanScaledMeanValue() const
 	{
 		ValueType sum = ValueType(0.0f);
 		int32 numSummed = 0;
@@ -403,9 +952,9 @@ public:
 		}
 	}
 
-	// Get the mean average value of all the values in the list scaled by the number of
+	// Scan the list for the mean average value of all the values in the list scaled by the number of
 	// values recorded in the list vs its maximum size.
-	ValueType GetAbsScaledMeanValue() const
+	ValueType ScanAbsScaledMeanValue() const
 	{
 		ValueType sum = ValueType(0.0f);
 		int32 numSummed = 0;
@@ -429,8 +978,8 @@ public:
 		}
 	}
 
-	// Get the sum value of all the values in the list.
-	ValueType GetSumValue(float since = -1.0f) const
+	// Scan the list for the sum value of all the values in the list.
+	ValueType ScanSumValue(float since) const
 	{
 		ValueType sum = ValueType(0.0f);
 
@@ -462,8 +1011,8 @@ public:
 		return sum;
 	}
 
-	// Get the sum value of all the values in the list.
-	ValueType GetAbsSumValue(float since = -1.0f) const
+	// Scan the list for the sum value of all the values in the list.
+	ValueType ScanAbsSumValue(float since) const
 	{
 		ValueType sum = ValueType(0.0f);
 
@@ -495,143 +1044,6 @@ public:
 		return sum;
 	}
 
-	// Get the value at a particular time in the list.
-	ValueType GetValueAt(float at) const
-	{
-		int32 i = NumValues - 1;
-
-		for (; i > 0; i--)
-		{
-			const FTimeValue& element = (*this)[i];
-
-			if (element.Time < at)
-			{
-				i++;
-				break;
-			}
-		}
-
-		return (i < NumValues) ? (*this)[i].Value : ValueType(0.0f);
-	}
-
-	// Get the difference between the value given and the value stored at at, and divide that
-	// by the time difference between the clock given and time stored at at, thus the change
-	// in the values that would occur over one second of time, regardless of how much time
-	// we're examining.
-	ValueType DifferenceFromPerSecond(float at, float clock, float value) const
-	{
-		int32 i = NumValues - 1;
-
-		for (; i > 0; i--)
-		{
-			const FTimeValue& element = (*this)[i];
-
-			if (element.Time < at)
-			{
-				i++;
-				break;
-			}
-		}
-
-		for (; i < NumValues; i++)
-		{
-			const FTimeValue& element = (*this)[i];
-
-			if (element.Time >= at)
-			{
-				float timeDifference = (clock - element.Time);
-
-				if (timeDifference > KINDA_SMALL_NUMBER)
-				{
-					return (value - element.Value) / timeDifference;
-				}
-				else
-				{
-					return value - element.Value;
-				}
-			}
-		}
-
-		float timeDifference = (clock - LastTime);
-
-		if (timeDifference > KINDA_SMALL_NUMBER)
-		{
-			return (value - LastValue) / timeDifference;
-		}
-		else
-		{
-			return value - LastValue;
-		}
-	}
-
-	// Get the time range of the values in the list.
-	float TimeRange() const
-	{
-		if (NumValues > 0)
-		{
-			return (*this)[NumValues - 1].Time - (*this)[0].Time;
-		}
-		else
-		{
-			return 0.0f;
-		}
-	}
-
-	// Clear the list of all recorded values.
-	void Clear()
-	{
-		Full = false;
-		NumValues = ReadCursor = WriteCursor = 0;
-	}
-
-	// Clear the list of all recorded values with a Time < time.
-	void Clear(float time)
-	{
-		while (NumValues > 0 &&
-			(*this)[0].Time < time)
-		{
-			Full = false;
-			NumValues--;
-			SetReadCursor();
-		}
-	}
-
-	// Get the number of values in the list.
-	int32 GetNumValues() const
-	{ return NumValues; }
-
-	// Get the maximum number of values in the list.
-	int32 GetMaxValues() const
-	{ return MaxValues; }
-
-	// Is the list full? Meaning is it storing its maximum capacity of of values yet?
-	bool IsFull() const
-	{ return Full; }
-
-	// Note that index 0 is the oldest value in the list and _numValues - 1 is the most recent.
-	const FTimeValue& operator [] (int32 index) const
-	{ return Values[(index + ReadCursor) & IndexMask]; }
-
-	// Assign a TTimedValueList to this object.
-	TTimedValueList<ValueType>& operator = (const TTimedValueList<ValueType>& other)
-	{
-		FMemory::Memcpy(this, &other, sizeof(other));
-
-		int32 numValues = IndexMask + 1;
-
-		Values = new FTimeValue[numValues];
-
-		FMemory::Memcpy(Values, other.Values, numValues * sizeof(FTimeValue));
-
-		return *this;
-	}
-
-private:
-
-	// Set the read cursor for the list after adding or removing values.
-	void SetReadCursor()
-	{ if ((ReadCursor = WriteCursor - (NumValues - 1)) < 0) ReadCursor = (IndexMask + 1) + ReadCursor; }
-
 	float MaxSeconds;
 
 	int32 IndexMask;
@@ -675,10 +1087,54 @@ private:
 	// Is the list full? Meaning is it storing its maximum capacity of of values yet?
 	bool Full;
 
+	// Are we keeping running statistics for the whole window of values in the list?
+	bool WindowStatistics;
+
+	// The number of values ever added to the list, used as a sequence number for them.
+	uint32 NumAdded;
+
+	// The sum of the negative values in the list, when keeping window statistics.
+	ValueType SumLow;
+
+	// The sum of the non-negative values in the list, when keeping window statistics.
+	ValueType SumHigh;
+
+	// The number of negative values in the list, when keeping window statistics.
+	int32 NumLow;
+
+	// The number of switches between negative and non-negative neighboring values in
+	// the list, when keeping window statistics.
+	int32 NumSwitches;
+
+	// The index of the front of the queue of candidate minimum values.
+	int32 MinHead;
+
+	// The number of entries in the queue of candidate minimum values.
+	int32 MinCount;
+
+	// The index of the front of the queue of candidate maximum values.
+	int32 MaxHead;
+
+	// The number of entries in the queue of candidate maximum values.
+	int32 MaxCount;
+
 	// The circular buffer storing the values.
-	FTimeValue* Values = nullptr;
+	TArray<FTimeValue, typename TTimedValueAllocator<Capacity>::Type> Values;
+
+	// The monotonic queue of the sequence numbers of the candidate minimum values in the
+	// list, oldest first and increasing in value, when keeping window statistics.
+	TArray<uint32> MinQueue;
+
+	// The monotonic queue of the sequence numbers of the candidate maximum values in the
+	// list, oldest first and decreasing in value, when keeping window statistics.
+	TArray<uint32> MaxQueue;
 };
 
+// A timed value list with a fixed, power of two capacity of values held inline, so
+// it never touches the heap unless keeping window statistics.
+template<typename ValueType, int32 Capacity>
+using TFixedTimedValueList = TTimedValueList<ValueType, Capacity>;
+
 // A timed value list for the float type.
 typedef TTimedValueList<float> FTimedFloatList;
 
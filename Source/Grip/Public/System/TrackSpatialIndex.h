@@ -0,0 +1,303 @@
+/**
+*
+* Spatial index of objects along the master racing spline.
+*
+* Original author: Rob Baker.
+* Current maintainer: Rob Baker.
+*
+* Copyright Caged Element Inc, code provided for educational purposes only.
+*
+* AI bots are only ever interested in objects that lie within a window along their
+* route, so rather than scanning every attractable or avoidable in the level, the
+* objects are kept sorted by their distance along the master racing spline, along
+* with their lateral offset from it. Queries then only visit the objects within
+* the window requested, found with a binary search.
+*
+* Objects are only re-indexed when they move, and then only with a narrow search
+* around where they were last indexed, so static objects like pickups cost almost
+* nothing to maintain.
+*
+***********************************************************************************/
+
+#pragma once
+
+#include "system/gameconfiguration.h"
+#include "ai/advancedsplinecomponent.h"
+#include "algo/binarysearch.h"
+
+DECLARE_STATS_GROUP(TEXT("GRIP AI"), STATGROUP_GripAI, STATCAT_Advanced);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Track Spatial Index Update"), STAT_TrackSpatialIndexUpdate, STATGROUP_GripAI, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Track Spatial Index Query"), STAT_TrackSpatialIndexQuery, STATGROUP_GripAI, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Track Spatial Index Queries"), STAT_TrackSpatialIndexQueries, STATGROUP_GripAI, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Track Spatial Index Candidates"), STAT_TrackSpatialIndexCandidates, STATGROUP_GripAI, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Track Spatial Index Skipped"), STAT_TrackSpatialIndexSkipped, STATGROUP_GripAI, );
+
+/**
+* Spatial index of objects, implementing an interface, along the master racing
+* spline.
+***********************************************************************************/
+
+template<typename InterfaceType>
+class TTrackSpatialIndex
+{
+public:
+
+	struct FEntry
+	{
+		// The actor for the object.
+		AActor* Actor = nullptr;
+
+		// The interface for the object.
+		InterfaceType* Interface = nullptr;
+
+		// The location of the object when it was last indexed.
+		FVector IndexedLocation = FVector::ZeroVector;
+
+		// The distance of the object along the spline.
+		float Distance = 0.0f;
+
+		// The lateral offset of the object from the spline center-line.
+		float LateralOffset = 0.0f;
+
+		// The range of influence of the object.
+		float Range = 0.0f;
+
+		// Has the object been indexed against the spline yet?
+		bool Indexed = false;
+	};
+
+	// Add an object to the index, it won't be found by queries until the next update.
+	void Add(AActor* actor, InterfaceType* object)
+	{ if (object != nullptr) { FEntry& entry = Entries.AddDefaulted_GetRef(); entry.Actor = actor; entry.Interface = object; Unindexed++; } }
+
+	// Remove an object from the index, preserving the order of the remaining objects.
+	void Remove(AActor* actor)
+	{ int32 index = Entries.IndexOfByPredicate([actor] (const FEntry& entry) { return entry.Actor == actor; }); if (index != INDEX_NONE) { if (Entries[index].Indexed == false) Unindexed--; Entries.RemoveAt(index, 1, false); } }
+
+	// Is the index usable for queries? If not then use ForEach instead.
+	bool IsValid() const
+	{ return Spline != nullptr && Unindexed == 0; }
+
+	// Get the number of objects in the index.
+	int32 Num() const
+	{ return Entries.Num(); }
+
+	// Get the largest range of influence of any object in the index.
+	float GetMaxRange() const
+	{ return MaxRange; }
+
+	// Get the lateral offset from the spline for a world location at a known distance along it.
+	bool GetLateralOffset(const FVector& location, float distance, float& lateralOffset) const
+	{ if (Spline == nullptr) return false; lateralOffset = Spline->WorldSpaceToSplineSpace(location, distance, true).Y; return true; }
+
+	// Update the index, re-indexing any objects that have moved by more than moveTolerance.
+	template<typename LocationFunc, typename RangeFunc>
+	void Update(const UAdvancedSplineComponent* spline, LocationFunc getLocation, RangeFunc getRange, float moveTolerance = 1.0f * 100.0f);
+
+	// Call func for every object within a window along the spline, from behind to
+	// ahead of distance, and within lateralRange of lateralOffset, extended by the
+	// range of each object.
+	template<typename Func>
+	void ForEachInWindow(float distance, float behind, float ahead, float lateralOffset, float lateralRange, Func func) const;
+
+	// Call func for every object in the index, used when the index isn't valid.
+	template<typename Func>
+	void ForEach(Func func) const
+	{ for (const FEntry& entry : Entries) func(entry); }
+
+private:
+
+	// Call func for all the objects between two distances, which must be within the spline length, returning the number visited.
+	template<typename Func>
+	int32 ForEachBetween(float fromDistance, float toDistance, float lateralOffset, float lateralRange, Func& func) const;
+
+	// The spline the objects are indexed against.
+	const UAdvancedSplineComponent* Spline = nullptr;
+
+	// The length of the spline the objects are indexed against.
+	float SplineLength = 0.0f;
+
+	// Is the spline the objects are indexed against a closed loop?
+	bool ClosedLoop = false;
+
+	// The largest range of influence of any object in the index.
+	float MaxRange = 0.0f;
+
+	// The number of objects that haven't been indexed yet.
+	int32 Unindexed = 0;
+
+	// The objects in the index, sorted by distance along the spline once updated.
+	TArray<FEntry> Entries;
+};
+
+/**
+* Update the index, re-indexing any objects that have moved by more than
+* moveTolerance.
+***********************************************************************************/
+
+template<typename InterfaceType>
+template<typename LocationFunc, typename RangeFunc>
+void TTrackSpatialIndex<InterfaceType>::Update(const UAdvancedSplineComponent* spline, LocationFunc getLocation, RangeFunc getRange, float moveTolerance)
+{
+	SCOPE_CYCLE_COUNTER(STAT_TrackSpatialIndexUpdate);
+
+	if (Spline != spline)
+	{
+		// A new spline means everything needs to be indexed from scratch.
+
+		Spline = spline;
+		Unindexed = Entries.Num();
+
+		for (FEntry& entry : Entries)
+		{
+			entry.Indexed = false;
+		}
+	}
+
+	if (Spline == nullptr)
+	{
+		return;
+	}
+
+	bool sort = (Unindexed > 0);
+
+	SplineLength = Spline->GetSplineLength();
+	ClosedLoop = Spline->IsClosedLoop();
+	MaxRange = 0.0f;
+
+	for (FEntry& entry : Entries)
+	{
+		FVector location = getLocation(entry.Interface);
+
+		entry.Range = getRange(entry.Interface);
+
+		MaxRange = FMath::Max(MaxRange, entry.Range);
+
+		if (entry.Indexed == false)
+		{
+			// A full search along the spline, which is slow, but only needs doing once.
+
+			entry.Distance = Spline->GetNearestDistance(location, 0.0f, 0.0f, 10, 50);
+		}
+		else
+		{
+			float moved = (location - entry.IndexedLocation).Size();
+
+			if (moved <= moveTolerance)
+			{
+				continue;
+			}
+
+			// The object is very unlikely to have moved much further along the spline than
+			// it has in the world, so we only need to search a little either side of where
+			// it was.
+
+			float range = moved + 10.0f * 100.0f;
+
+			entry.Distance = Spline->GetNearestDistance(location, entry.Distance - range, entry.Distance + range, 4, Spline->GetNumSamplesForRange(range * 2.0f, 4, 10.0f));
+		}
+
+		entry.LateralOffset = Spline->WorldSpaceToSplineSpace(location, entry.Distance, true).Y;
+		entry.IndexedLocation = location;
+		entry.Indexed = true;
+
+		sort = true;
+	}
+
+	Unindexed = 0;
+
+	if (sort == true)
+	{
+		Entries.Sort([] (const FEntry& object1, const FEntry& object2)
+			{
+				return object1.Distance < object2.Distance;
+			});
+	}
+}
+
+/**
+* Call func for every object within a window along the spline, from behind to
+* ahead of distance, and within lateralRange of lateralOffset, extended by the
+* range of each object.
+***********************************************************************************/
+
+template<typename InterfaceType>
+template<typename Func>
+void TTrackSpatialIndex<InterfaceType>::ForEachInWindow(float distance, float behind, float ahead, float lateralOffset, float lateralRange, Func func) const
+{
+	SCOPE_CYCLE_COUNTER(STAT_TrackSpatialIndexQuery);
+
+	INC_DWORD_STAT(STAT_TrackSpatialIndexQueries);
+
+	if (Entries.Num() == 0)
+	{
+		return;
+	}
+
+	int32 visited = 0;
+	float fromDistance = distance - behind;
+	float toDistance = distance + ahead;
+
+	if (toDistance - fromDistance >= SplineLength)
+	{
+		visited += ForEachBetween(0.0f, SplineLength, lateralOffset, lateralRange, func);
+	}
+	else if (ClosedLoop == true)
+	{
+		// The window may wrap around the start line, in which case query each side of it.
+
+		fromDistance = Spline->ClampDistanceAgainstLength(fromDistance, SplineLength);
+		toDistance = Spline->ClampDistanceAgainstLength(toDistance, SplineLength);
+
+		if (fromDistance <= toDistance)
+		{
+			visited += ForEachBetween(fromDistance, toDistance, lateralOffset, lateralRange, func);
+		}
+		else
+		{
+			visited += ForEachBetween(fromDistance, SplineLength, lateralOffset, lateralRange, func);
+			visited += ForEachBetween(0.0f, toDistance, lateralOffset, lateralRange, func);
+		}
+	}
+	else
+	{
+		visited += ForEachBetween(FMath::Max(fromDistance, 0.0f), FMath::Min(toDistance, SplineLength), lateralOffset, lateralRange, func);
+	}
+
+	// Record how many objects were visited compared to a full scan of the index.
+
+	INC_DWORD_STAT_BY(STAT_TrackSpatialIndexCandidates, visited);
+	INC_DWORD_STAT_BY(STAT_TrackSpatialIndexSkipped, Entries.Num() - visited);
+}
+
+/**
+* Call func for all the objects between two distances, which must be within the
+* spline length, returning the number visited.
+***********************************************************************************/
+
+template<typename InterfaceType>
+template<typename Func>
+int32 TTrackSpatialIndex<InterfaceType>::ForEachBetween(float fromDistance, float toDistance, float lateralOffset, float lateralRange, Func& func) const
+{
+	int32 index = Algo::LowerBoundBy(Entries, fromDistance, [] (const FEntry& entry) { return entry.Distance; });
+	int32 visited = 0;
+
+	for (; index < Entries.Num(); index++)
+	{
+		const FEntry& entry = Entries[index];
+
+		if (entry.Distance > toDistance)
+		{
+			break;
+		}
+
+		if (FMath::Abs(entry.LateralOffset - lateralOffset) <= lateralRange + entry.Range)
+		{
+			visited++;
+
+			func(entry);
+		}
+	}
+
+	return visited;
+}
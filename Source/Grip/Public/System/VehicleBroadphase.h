@@ -0,0 +1,123 @@
+/**
+*
+* Proximity broadphase for vehicle-to-vehicle queries.
+*
+* Original author: Rob Baker.
+* Current maintainer: Rob Baker.
+*
+* Copyright Caged Element Inc, code provided for educational purposes only.
+*
+* Lots of systems need to know which vehicles are near a location, or within a
+* cone in front of it, or close by in the race. Rather than each of them looping
+* over every vehicle in the game, the broadphase is built once per frame with the
+* vehicles sorted by race distance and bucketed into a uniform grid over their
+* bounds, so that queries only need to look at the vehicles nearby.
+*
+* Queries are conservative, returning all of the vehicles that may satisfy them,
+* accounting for vehicle size and for the movement of vehicles since the
+* broadphase was built. Callers are still expected to perform their own exact
+* tests on the vehicles returned.
+*
+***********************************************************************************/
+
+#pragma once
+
+#include "system/gameconfiguration.h"
+
+class ABaseVehicle;
+
+/**
+* Proximity broadphase for vehicle-to-vehicle queries.
+***********************************************************************************/
+
+class FVehicleBroadphase
+{
+public:
+
+	// The vehicles returned from a query, in race distance order.
+	typedef TArray<ABaseVehicle*, TInlineAllocator<16>> FVehicleList;
+
+	// Build the broadphase from a list of vehicles.
+	void Build(const TArray<ABaseVehicle*>& vehicles, float deltaSeconds);
+
+	// Get the vehicles that may be within radius of a location.
+	void QueryNeighbours(const FVector& location, float radius, FVehicleList& results) const;
+
+	// Get the vehicles that may be within maxDistance of a location and inside a cone
+	// around a unit direction, where minCosAngle is the cosine of the half-angle of the cone.
+	void QueryCone(const FVector& location, const FVector& direction, float maxDistance, float minCosAngle, FVehicleList& results) const;
+
+	// Get the vehicles whose eternal race distance is between two distances.
+	void QueryRaceDistance(float fromDistance, float toDistance, FVehicleList& results) const;
+
+	// Get all of the vehicles, sorted by eternal race distance, trailing first.
+	const TArray<ABaseVehicle*>& GetVehiclesByRaceDistance() const
+	{ return VehiclesByRaceDistance; }
+
+	// Get the number of vehicles in the broadphase.
+	int32 Num() const
+	{ return Entries.Num(); }
+
+	// Get the padding applied to queries to account for vehicle size and movement.
+	float GetPadding() const
+	{ return Padding; }
+
+private:
+
+	// A vehicle in the broadphase.
+	struct FVehicleEntry
+	{
+		// The vehicle.
+		ABaseVehicle* Vehicle = nullptr;
+
+		// The location of the vehicle when the broadphase was built.
+		FVector Location = FVector::ZeroVector;
+
+		// The eternal race distance of the vehicle when the broadphase was built.
+		float RaceDistance = 0.0f;
+	};
+
+	// Get the grid cell coordinate for a world coordinate on the X axis.
+	int32 GetCellX(float x) const
+	{ return FMath::Clamp(FMath::FloorToInt((x - Bounds.Min.X) * InvCellSize), 0, GridWidth - 1); }
+
+	// Get the grid cell coordinate for a world coordinate on the Y axis.
+	int32 GetCellY(float y) const
+	{ return FMath::Clamp(FMath::FloorToInt((y - Bounds.Min.Y) * InvCellSize), 0, GridHeight - 1); }
+
+	// Gather the indices of the entries in the grid cells overlapping a sphere, in race distance order.
+	void GatherCandidates(const FVector& location, float radius, TArray<int32, TInlineAllocator<16>>& candidates) const;
+
+	// The vehicles in the broadphase, sorted by eternal race distance, trailing first.
+	TArray<FVehicleEntry> Entries;
+
+	// The vehicles in the broadphase, sorted by eternal race distance, trailing first.
+	TArray<ABaseVehicle*> VehiclesByRaceDistance;
+
+	// The bounds of the grid in world space.
+	FBox Bounds = FBox(ForceInit);
+
+	// The reciprocal of the size of each grid cell.
+	float InvCellSize = 0.0f;
+
+	// The number of grid cells on the X axis.
+	int32 GridWidth = 0;
+
+	// The number of grid cells on the Y axis.
+	int32 GridHeight = 0;
+
+	// The index into CellEntries of the first entry in each grid cell, with a trailing end index.
+	TArray<int32> CellStarts;
+
+	// The indices of the entries in each grid cell, packed contiguously by cell.
+	TArray<int32> CellEntries;
+
+	// The padding applied to queries to account for vehicle size and movement.
+	float Padding = 0.0f;
+
+	// The size of each grid cell, in centimeters, before being enlarged to limit the grid size.
+	static const float CellSize;
+
+	// The maximum number of grid cells along either axis.
+	static const int32 MaxGridCells = 64;
+};
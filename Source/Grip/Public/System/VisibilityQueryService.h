@@ -0,0 +1,182 @@
+/**
+*
+* Asynchronous line-of-sight query service.
+*
+* Original author: Rob Baker.
+* Current maintainer: Rob Baker.
+*
+* Copyright Caged Element Inc, code provided for educational purposes only.
+*
+* Lots of systems, like targeting, the AI bots and the cinematic cameras, need to
+* know whether one thing can see another, and most of them can tolerate knowing a
+* frame late. Rather than each of them performing synchronous line traces on the
+* game thread, the service issues asynchronous traces through the engine, picks
+* up their results on the next frame, and caches them per source and target pair
+* for as long as the caller considers them valid and the end points of the trace
+* haven't moved too far from where it was made.
+*
+***********************************************************************************/
+
+#pragma once
+
+#include "system/gameconfiguration.h"
+
+/**
+* What to do when a line-of-sight query has no result available yet.
+***********************************************************************************/
+
+enum class EVisibilityQueryFallback : uint8
+{
+	// Perform a synchronous line trace to get the result immediately.
+	Synchronous,
+
+	// Assume the target is visible until the asynchronous result arrives.
+	AssumeVisible,
+
+	// Assume the target is hidden until the asynchronous result arrives.
+	AssumeHidden
+};
+
+/**
+* Statistics for the visibility query service, for the last frame.
+***********************************************************************************/
+
+struct FVisibilityQueryStats
+{
+	// The number of queries made.
+	int32 Queries = 0;
+
+	// The number of queries answered from a valid cached result.
+	int32 CacheHits = 0;
+
+	// The number of asynchronous traces issued.
+	int32 AsyncTraces = 0;
+
+	// The number of synchronous traces performed because there was no result available.
+	int32 SyncTraces = 0;
+
+	// The number of source and target pairs being tracked.
+	int32 TrackedPairs = 0;
+};
+
+/**
+* Asynchronous line-of-sight query service.
+***********************************************************************************/
+
+class FVisibilityQueryService
+{
+public:
+
+	// Get the world that the service traces within.
+	UWorld* GetWorld() const
+	{ return World; }
+
+	// Set the world that the service traces within.
+	void SetWorld(UWorld* world)
+	{ World = world; Queries.Reset(); }
+
+	// Can a target be seen from a source? The result is cached for validFor seconds,
+	// or until either end point moves more than EndpointTolerance from where it was
+	// traced, and an asynchronous trace is issued to refresh it before then. If there's
+	// no valid result, the fallback determines what's returned. The trace tag in params
+	// distinguishes between different kinds of query on the same source and target.
+	bool IsVisible(const void* source, const void* target, const FVector& from, const FVector& to, ECollisionChannel channel, const FCollisionQueryParams& params, float validFor, EVisibilityQueryFallback fallback);
+
+	// Tick the service at the end of a frame, collecting the results of asynchronous
+	// traces and forgetting queries that are no longer being made.
+	void Tick();
+
+	// Get the statistics for the last frame.
+	const FVisibilityQueryStats& GetStats() const
+	{ return Stats; }
+
+	// Can a target be seen from a source? Uses the service of the play game mode if
+	// there is one, or a synchronous line trace otherwise.
+	static bool LineOfSight(const UObject* worldContextObject, const void* source, const void* target, const FVector& from, const FVector& to, ECollisionChannel channel, const FCollisionQueryParams& params, float validFor, EVisibilityQueryFallback fallback);
+
+private:
+
+	// The key for a source and target pair, for a particular kind of query.
+	struct FVisibilityQueryKey
+	{
+		FVisibilityQueryKey(const void* source, const void* target, FName tag)
+			: Source(source)
+			, Target(target)
+			, Tag(tag)
+		{ }
+
+		bool operator == (const FVisibilityQueryKey& other) const
+		{ return Source == other.Source && Target == other.Target && Tag == other.Tag; }
+
+		friend uint32 GetTypeHash(const FVisibilityQueryKey& key)
+		{ return HashCombine(HashCombine(PointerHash(key.Source), PointerHash(key.Target)), GetTypeHash(key.Tag)); }
+
+		// The source of the query.
+		const void* Source = nullptr;
+
+		// The target of the query.
+		const void* Target = nullptr;
+
+		// The trace tag of the query.
+		FName Tag;
+	};
+
+	// The state of a query for a source and target pair.
+	struct FVisibilityQuery
+	{
+		// The handle of the asynchronous trace in flight, if any.
+		FTraceHandle Handle;
+
+		// The start of the asynchronous trace in flight.
+		FVector TraceFrom = FVector::ZeroVector;
+
+		// The end of the asynchronous trace in flight.
+		FVector TraceTo = FVector::ZeroVector;
+
+		// The start of the trace for the last result.
+		FVector From = FVector::ZeroVector;
+
+		// The end of the trace for the last result.
+		FVector To = FVector::ZeroVector;
+
+		// The time the last result was obtained.
+		float ResultTime = 0.0f;
+
+		// The time the query was last made.
+		float RequestTime = 0.0f;
+
+		// Is there a result available?
+		bool HasResult = false;
+
+		// Was the target visible in the last result?
+		bool Visible = false;
+	};
+
+	// Collect the result of any asynchronous trace in flight for a query.
+	void CollectResult(FVisibilityQuery& query, float time);
+
+	// Issue an asynchronous trace for a query, unless a similar one is already in flight.
+	void IssueAsyncTrace(FVisibilityQuery& query, const FVector& from, const FVector& to, ECollisionChannel channel, const FCollisionQueryParams& params);
+
+	// Are two pairs of trace end points within a scale of EndpointTolerance of one another?
+	static bool EndpointsMatch(const FVector& from0, const FVector& to0, const FVector& from1, const FVector& to1, float scale = 1.0f)
+	{ float tolerance = FMath::Square(EndpointTolerance * scale); return FVector::DistSquared(from0, from1) <= tolerance && FVector::DistSquared(to0, to1) <= tolerance; }
+
+	// The world that the service traces within.
+	UWorld* World = nullptr;
+
+	// The queries being tracked, by source and target pair.
+	TMap<FVisibilityQueryKey, FVisibilityQuery> Queries;
+
+	// The statistics being accumulated for this frame.
+	FVisibilityQueryStats FrameStats;
+
+	// The statistics for the last frame.
+	FVisibilityQueryStats Stats;
+
+	// How long a query can go without being made before it's forgotten, in seconds.
+	static const float ForgetAfter;
+
+	// How far either end point can move from where a result was traced before it's no longer valid, in centimeters.
+	static const float EndpointTolerance;
+};
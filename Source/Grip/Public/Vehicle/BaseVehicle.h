@@ -241,6 +241,9 @@ struct FPlayerPickupSlot
 	// Time delay after becoming efficacious to use that the bot can start to think about using it.
 	float EfficacyTimer = 0.0f;
 
+	// The vehicle clock when the efficacy of the pickup was last checked.
+	float EfficacyCheckedAt = 0.0f;
+
 	// Time the bot must use the pickup from the beginning of this time range.
 	float UseAfter = 0.0f;
 
@@ -352,7 +355,7 @@ struct FVehicleControl
 	FDynamicForceFeedbackHandle ForceFeedbackHandle = 0;
 
 	// The list of throttle inputs.
-	FTimedFloatList ThrottleList = FTimedFloatList(1, 30);
+	TFixedTimedValueList<float, 32> ThrottleList = TFixedTimedValueList<float, 32>(1, 30);
 };
 
 #pragma endregion VehicleControls
@@ -497,6 +500,9 @@ struct FVehicleWheels
 	// The wheels attached to the vehicle.
 	TArray<FVehicleWheel> Wheels;
 
+	// The hot data for the wheels attached to the vehicle, used in computing tire forces.
+	FVehicleWheelsHotData HotData;
+
 #pragma region VehicleSurfaceEffects
 
 	// Timer used for coordinating surface effects.
@@ -1111,7 +1117,8 @@ private:
 	const FTransform& GetPhysicsTransform() const
 	{ return Physics.PhysicsTransform; }
 
-	// Do the regular physics update tick.
+	// Do the regular physics update tick, specialized for wheeled or antigravity vehicles.
+	template <bool TAntigravity>
 	void SubstepPhysics(float deltaSeconds, FBodyInstance* bodyInstance);
 
 	// The propulsion properties for the vehicle.
@@ -1242,7 +1249,8 @@ private:
 	// Get the normal of the nearest driving surface.
 	FVector GetSurfaceNormal() const;
 
-	// Update the contact sensors.
+	// Update the contact sensors, specialized for wheeled or antigravity vehicles.
+	template <bool TAntigravity>
 	int32 UpdateContactSensors(float deltaSeconds, const FTransform& transform, const FVector& xdirection, const FVector& ydirection, const FVector& zdirection);
 
 	// Get the name of the surface the vehicle is currently driving on.
@@ -1273,8 +1281,18 @@ public:
 	// Get the predicted velocity based on recorded velocity information.
 	FVector GetPredictedVelocity() const;
 
+	// Get the frame snapshot of the vehicle, taken at the end of the last frame by the game mode.
+	// Use this rather than the individual queries it contains when reading the state of another
+	// vehicle. The vehicle itself, and anything acting on its behalf during its own tick, like its
+	// pickups, should use the live queries instead as the snapshot is always last frame's state.
+	const FVehicleFrameSnapshot& GetFrameSnapshot() const
+	{ static const FVehicleFrameSnapshot defaultSnapshot; return (PlayGameMode != nullptr) ? PlayGameMode->GetVehicleSnapshot(VehicleIndex) : defaultSnapshot; }
+
 private:
 
+	// Take the frame snapshot of the vehicle and publish it to the game mode.
+	void UpdateFrameSnapshot();
+
 	// Arrest the vehicle until the game has started.
 	void ArrestVehicle();
 
@@ -1385,7 +1403,7 @@ private:
 	void CalculateWheelRotationRate(FVehicleWheel& wheel, const FVector& velocityDirection, float vehicleSpeed, float brakePosition, float deltaSeconds);
 
 	// Get the lateral friction for a dot product result between normalized wheel velocity vs the wheel side vector.
-	float LateralFriction(float baselineFriction, float sideSlip, FVehicleWheel& wheel) const;
+	float LateralFriction(float baselineFriction, float sideSlip, float speed) const;
 
 	// Calculate the longitudinal grip ratio for a slip value.
 	float CalculateLongitudinalGripRatioForSlip(float slip) const;
@@ -1906,6 +1924,12 @@ public:
 	// Collect the speed pads overlapping with a vehicle.
 	void CollectSpeedPads();
 
+private:
+
+	// The speed pads currently overlapping with the vehicle's collision shell, maintained
+	// by the overlap events.
+	TArray<TWeakObjectPtr<ASpeedPad>, TInlineAllocator<4>> OverlappingSpeedPads;
+
 #pragma endregion SpeedPads
 
 #pragma region VehicleBoost
@@ -1938,6 +1962,18 @@ private:
 	// Collect the pickups overlapping with a vehicle.
 	void CollectPickups();
 
+	// Handle the vehicle's collision shell beginning to overlap a speed pad or pickup.
+	UFUNCTION()
+		void OnPadBeginOverlap(class UPrimitiveComponent* overlappedComponent, class AActor* otherActor, class UPrimitiveComponent* otherComponent, int32 otherBodyIndex, bool fromSweep, const FHitResult& sweepResult);
+
+	// Handle the vehicle's collision shell ending its overlap with a speed pad or pickup.
+	UFUNCTION()
+		void OnPadEndOverlap(class UPrimitiveComponent* overlappedComponent, class AActor* otherActor, class UPrimitiveComponent* otherComponent, int32 otherBodyIndex);
+
+	// The pickups currently overlapping with the vehicle's collision shell, maintained
+	// by the overlap events.
+	TArray<TWeakObjectPtr<APickup>, TInlineAllocator<4>> OverlappingPickups;
+
 #pragma endregion PickupPads
 
 #pragma region VehiclePickups
@@ -1948,6 +1984,10 @@ public:
 	bool CanBeAttacked() const
 	{ return ((AI.BotVehicle == true) ? true : VehicleClock > AttackAfter); }
 
+	// Get the threats incoming on this vehicle, sorted by time to impact, soonest first.
+	const FThreatRegistry::FThreatList& GetIncomingThreats() const
+	{ static const FThreatRegistry::FThreatList noThreats; return (PlayGameMode != nullptr) ? PlayGameMode->GetThreatRegistry().GetIncoming(VehicleIndex) : noThreats; }
+
 	// Get a scale for damage inflicted by weapons, taking into account double damage etc.
 	int32 GetDamageScale() const
 	{ return (RaceState.DoubleDamage > 0.0f) ? 2 : 1; }
@@ -2526,14 +2566,13 @@ private:
 	// The vehicle clock, ticking as per its own time dilation, especially when the Disruptor is active.
 	float VehicleClock;
 
-	// A time sharing clock for a half second period.
-	FTimeShareClock Clock0p5 = FTimeShareClock(0.5f);
-
-	// A time sharing clock for a quarter second period.
-	FTimeShareClock Clock0p25 = FTimeShareClock(0.25f);
+	// Get the scheduler for AI work, if there is one.
+	FAIWorkScheduler* GetAIWorkScheduler() const
+	{ return (PlayGameMode != nullptr) ? &PlayGameMode->GetAIWorkScheduler() : nullptr; }
 
-	// A time sharing clock for a tenth of a second period.
-	FTimeShareClock Clock0p1 = FTimeShareClock(0.1f);
+	// Should a type of AI work be done on this frame?
+	bool ShouldRunAIWork(EAIWorkType type) const
+	{ return (PlayGameMode != nullptr) ? PlayGameMode->GetAIWorkScheduler().ShouldRunNow(VehicleIndex, type) : true; }
 
 #pragma endregion ClocksAndTime
 
@@ -2587,6 +2626,10 @@ public:
 	UFUNCTION(BlueprintCallable, Category = System)
 		UParticleSystemComponent* SpawnParticleSystem(UParticleSystem* emitterTemplate, FName attachPointName, FVector location, FRotator rotation, EAttachLocation::Type locationType, float scale = 1.0f, bool autoDestroy = true);
 
+	// Spawn an appropriately scaled, short-lived particle system on the vehicle, taken
+	// from the world's particle system pool rather than being created afresh.
+	UParticleSystemComponent* SpawnPooledParticleSystem(UParticleSystem* emitterTemplate, FName attachPointName, FVector location, FRotator rotation, float scale = 1.0f);
+
 	// Is the vehicle current using cockpit-camera view?
 	UFUNCTION(BlueprintCallable, Category = "General")
 		bool IsCockpitView() const
@@ -2948,6 +2991,7 @@ private:
 	friend class ADebugVehicleHUD;
 	friend class ADebugCatchupHUD;
 	friend class ADebugRaceCameraHUD;
+	friend class APlayGameMode;
 
 #pragma endregion FriendClasses
 
@@ -37,7 +37,8 @@ public:
 	// Setup a new sensor.
 	void Setup(ABaseVehicle* vehicle, int32 alignment, float side, float startOffset, float wheelWidth, float wheelRadius, float restingCompression);
 
-	// Do the regular update tick.
+	// Do the regular update tick, specialized for wheeled or antigravity vehicles.
+	template <bool TAntigravity>
 	void Tick(float deltaTime, UWorld* world, const FTransform& transform, const FVector& startPoint, const FVector& direction, bool updatePhysics, bool estimate, bool calculateIfUpward);
 
 	// Calculate the nearest contact point of the sensor in world space.
@@ -286,7 +287,7 @@ private:
 	float HoverContactDistance = 0.0f;
 
 	// Values for suspension compression over time.
-	FTimedFloatList CompressionList = FTimedFloatList(1, 10);
+	TFixedTimedValueList<float, 16> CompressionList = TFixedTimedValueList<float, 16>(1, 10);
 
 	// The shape to be used for performing a sensor sweep.
 	FCollisionShape SweepShape;
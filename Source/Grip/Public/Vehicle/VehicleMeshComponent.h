@@ -64,6 +64,9 @@ public:
 	// Set the physics inertia tensor of the vehicle.
 	FVector GetPhysicsInertiaTensor() const;
 
+	// Get the physics center of mass of the vehicle in world space.
+	FVector GetPhysicsCenterOfMass() const;
+
 	// Set the angular damping of the vehicle.
 	virtual void SetAngularDamping(float damping) override
 	{
@@ -193,6 +196,12 @@ public:
 	void SetAllPhysicsLinearVelocitySubstep(const FVector& velocity, bool addToCurrent = false)
 	{ SetPhysicsLinearVelocitySubstep(velocity, addToCurrent); }
 
+	// Begin accumulating the forces applied during a physics sub-step.
+	void BeginForceAccumulation();
+
+	// End accumulating the forces applied during a physics sub-step, applying them to the physics body.
+	void EndForceAccumulation();
+
 	// Is the vehicle idle?
 	bool IsIdle() const
 	{ return IdleLocked > 0; }
@@ -242,6 +251,12 @@ public:
 
 private:
 
+	// Accumulate a force for the current physics sub-step, returning true if it was accumulated.
+	bool AccumulateForce(const FVector& force);
+
+	// Accumulate a force at a location in world space for the current physics sub-step, returning true if it was accumulated.
+	bool AccumulateForceAtLocation(const FVector& force, const FVector& location);
+
 	// The handle of the physics actor.
 	FPhysicsActorHandle ActorHandle;
 
@@ -259,6 +274,24 @@ private:
 
 	// The rotation we're locked at idle.
 	FQuat IdleRotation = FQuat::Identity;
+
+	// Are we currently accumulating forces for a physics sub-step?
+	bool AccumulatingForces = false;
+
+	// The center of mass in world space of the physics body at the start of the accumulation.
+	FVector AccumulationCenterOfMass = FVector::ZeroVector;
+
+	// The total force accumulated for the current physics sub-step.
+	FVector AccumulatedForce = FVector::ZeroVector;
+
+	// The total torque accumulated for the current physics sub-step.
+	FVector AccumulatedTorque = FVector::ZeroVector;
+
+	// The total force applied individually to the physics body, for checking the accumulation.
+	FVector DebugAppliedForce = FVector::ZeroVector;
+
+	// The total torque applied individually to the physics body, for checking the accumulation.
+	FVector DebugAppliedTorque = FVector::ZeroVector;
 };
 
 #pragma endregion MinimalVehicle
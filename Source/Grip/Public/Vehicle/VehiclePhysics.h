@@ -207,10 +207,10 @@ struct FPhysicsContactData
 	float FallingTime = 0.0f;
 
 	// Record of grounded value values.
-	FTimedFloatList GroundedList = FTimedFloatList(5, 10);
+	TFixedTimedValueList<float, 64> GroundedList = TFixedTimedValueList<float, 64>(5, 10);
 
 	// Record of airborne value values.
-	FTimedFloatList AirborneList = FTimedFloatList(5, 10);
+	TFixedTimedValueList<float, 64> AirborneList = TFixedTimedValueList<float, 64>(5, 10);
 };
 
 /**
@@ -311,22 +311,22 @@ struct FPhysicsDrifting
 struct FVehiclePhysics
 {
 	// Record of local yaw change values.
-	FTimedFloatList PitchChangeList = FTimedFloatList(10, 25, false, true);
+	TFixedTimedValueList<float, 256> PitchChangeList = TFixedTimedValueList<float, 256>(10, 25, false, true);
 
 	// Record of velocity direction pitch values.
 	// This has a high sampling rate as we want to ensure we have the latest information for use
 	// by the physics system and reactions are fast.
-	FTimedFloatList VelocityPitchList = FTimedFloatList(5, 200, false);
+	TFixedTimedValueList<float, 1024> VelocityPitchList = TFixedTimedValueList<float, 1024>(5, 200, false);
 
 	// Record of angular velocity pitch values.
-	FTimedFloatList AngularPitchList = FTimedFloatList(5, 25);
+	TFixedTimedValueList<float, 128> AngularPitchList = TFixedTimedValueList<float, 128>(5, 25);
 
 	// Used for measuring how different a vehicle's direction is compared to its velocity vector.
 	// This helps us to determine future path more effectively.
-	FTimedVectorList DirectionVsVelocityList = FTimedVectorList(5, 25);
+	TFixedTimedValueList<FVector, 128> DirectionVsVelocityList = TFixedTimedValueList<FVector, 128>(5, 25);
 
 	// Used for detecting and setting up bounces.
-	FTimedVectorList VelocityList = FTimedVectorList(5, 25);
+	TFixedTimedValueList<FVector, 128> VelocityList = TFixedTimedValueList<FVector, 128>(5, 25);
 
 	// The timer for velocity pitch mitigation.
 	float VelocityPitchMitigationTime = 0.0f;
@@ -449,4 +449,51 @@ struct FVehiclePhysics
 	FPhysicsBounce Bounce;
 };
 
+/**
+* An immutable snapshot of the state of a vehicle, taken for all vehicles at once
+* at the end of each frame and shared by everything that queries that state during
+* the next frame. A vehicle doesn't read its own snapshot, it uses its live state.
+*
+* This is packed into a single cache line so that the fleet-wide array of these
+* can be walked by worker threads without false sharing or touching the vehicles.
+***********************************************************************************/
+
+struct alignas(PLATFORM_CACHE_LINE_SIZE) FVehicleFrameSnapshot
+{
+	// The predicted velocity of the vehicle, see ABaseVehicle::GetPredictedVelocity.
+	FVector PredictedVelocity = FVector::ZeroVector;
+
+	// The direction from the vehicle to the nearest driving surface.
+	FVector SurfaceDirection = FVector(0.0f, 0.0f, -1.0f);
+
+	// The normal of the nearest driving surface, see ABaseVehicle::GetSurfaceNormal.
+	FVector SurfaceNormal = FVector::ZeroVector;
+
+	// The guessed normal of the nearest driving surface, see ABaseVehicle::GuessSurfaceNormal.
+	FVector GuessedSurfaceNormal = FVector::ZeroVector;
+
+	// The speed of the vehicle, in kilometers per hour.
+	float SpeedKPH = 0.0f;
+
+	// The average distance of the wheels to the nearest driving surface, 0 for not near any driving surface.
+	float SurfaceDistance = 0.0f;
+
+	// The frame number that the snapshot was taken on (truncated GFrameCounter).
+	uint32 FrameNumber = 0;
+
+	// Is the vehicle currently with all wheels off the ground?
+	bool Airborne = false;
+
+	// Is the vehicle currently with all wheels off the ground, ignoring skipping?
+	bool AirborneIgnoringSkipping = false;
+
+	// Is the vehicle currently with all wheels (more or less) on the ground?
+	bool PracticallyGrounded = false;
+};
+
+static_assert(sizeof(FVehicleFrameSnapshot) == PLATFORM_CACHE_LINE_SIZE, "FVehicleFrameSnapshot should occupy a single cache line");
+
+// An array of vehicle frame snapshots, with each snapshot aligned on its own cache line.
+typedef TArray<FVehicleFrameSnapshot, TAlignedHeapAllocator<PLATFORM_CACHE_LINE_SIZE>> FVehicleFrameSnapshots;
+
 #pragma endregion MinimalVehicle
@@ -252,4 +252,71 @@ private:
 	friend class ADebugRaceCameraHUD;
 };
 
+/**
+* A packed, structure-of-arrays block of the hot wheel data used in computing the
+* tire forces on every physics sub-step. It's laid out so that the wheel kinematics
+* can be computed four wheels at a time using vector instructions. The cold data,
+* like hit results and surface effects, stays with FVehicleWheel and its sensors.
+***********************************************************************************/
+
+struct FVehicleWheelsHotData
+{
+public:
+
+	// The number of wheels processed together in each vector operation.
+	static const int32 VectorWidth = 4;
+
+	// The maximum number of wheels supported, a multiple of the vector width.
+	static const int32 MaxWheels = VectorWidth * 2;
+
+	// Set the number of wheels in use, clearing all of the data.
+	void SetNumWheels(int32 numWheels);
+
+	// Get the number of wheels in use.
+	int32 GetNumWheels() const
+	{ return NumWheels; }
+
+	// Set the location of a wheel in world space.
+	void SetLocation(int32 index, const FVector& location)
+	{ if (index >= 0 && index < NumWheels) { LocationX[index] = location.X; LocationY[index] = location.Y; LocationZ[index] = location.Z; } }
+
+	// Calculate the velocities of all of the wheels from the rigid body state of the vehicle.
+	void CalculateVelocities(const FVector& linearVelocity, const FVector& angularVelocity, const FVector& centerOfMass, const FVector& upDirection);
+
+	// Get the velocity of a wheel in world space.
+	FVector GetVelocity(int32 index) const
+	{ return FVector(VelocityX[index], VelocityY[index], VelocityZ[index]); }
+
+	// Get the velocity of a wheel in world space, with the vertical component of the vehicle removed.
+	FVector GetHorizontalVelocity(int32 index) const
+	{ return FVector(HorizontalVelocityX[index], HorizontalVelocityY[index], HorizontalVelocityZ[index]); }
+
+	// Get the speed of a wheel, in centimeters per second.
+	float GetSpeed(int32 index) const
+	{ return FMath::Sqrt(SpeedSquared[index]); }
+
+private:
+
+	// The number of wheels in use.
+	int32 NumWheels = 0;
+
+	// The location of the wheels in world space.
+	float LocationX[MaxWheels];
+	float LocationY[MaxWheels];
+	float LocationZ[MaxWheels];
+
+	// The velocity of the wheels in world space.
+	float VelocityX[MaxWheels];
+	float VelocityY[MaxWheels];
+	float VelocityZ[MaxWheels];
+
+	// The velocity of the wheels in world space, with the vertical component of the vehicle removed.
+	float HorizontalVelocityX[MaxWheels];
+	float HorizontalVelocityY[MaxWheels];
+	float HorizontalVelocityZ[MaxWheels];
+
+	// The squared speed of the wheels.
+	float SpeedSquared[MaxWheels];
+};
+
 #pragma endregion VehicleContactSensors